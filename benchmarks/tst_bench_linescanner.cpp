@@ -0,0 +1,179 @@
+// Copyright (C) 2026 Sergey Naumov <sergey@naumov.io>
+// SPDX-License-Identifier: 0BSD
+
+#include "qloaderparser.h"
+#include <QBuffer>
+#include <QTest>
+#include <QTextStream>
+
+using namespace Qt::Literals::StringLiterals;
+
+class BaselineParser
+{
+public:
+    qsizetype keyValues{};
+    qsizetype sections{};
+    qsizetype textSize{};
+
+    static bool matchSectionName(const QString &line, QString &section)
+    {
+        if (line.size() > 2 &&
+            line.front() == u'[' &&
+            line.back() == u']' &&
+            line.indexOf(u'[', 1) == -1 &&
+            line.lastIndexOf(u']', -2) == -1)
+        {
+            section = line.sliced(1, line.size() - 2);
+            return true;
+        }
+
+        return false;
+    }
+
+    static bool matchKeyValue(const QString &line, QString &key, QString &value)
+    {
+        int splitIndex = line.indexOf(u'=');
+
+        if (splitIndex > 0)
+        {
+            QStringView view(line);
+
+            if ((view = view.first(splitIndex).trimmed()).size())
+            {
+                key = view.toString();
+                value = QStringView(line).sliced(splitIndex + 1).trimmed().toString();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void parse(QIODevice *device)
+    {
+        QTextStream in(device);
+        QString line;
+        line.reserve(10240);
+        int currentLine{};
+
+        const QLatin1StringView shebang("#!"_L1);
+        const QChar comment('#'_L1);
+
+        while (!in.atEnd())
+        {
+            in.readLineInto(&line);
+            ++currentLine;
+
+            if (currentLine == 1 && line.startsWith(shebang))
+                continue;
+
+            if (line.isEmpty() || line.startsWith(comment))
+                continue;
+
+            QString section, key, value;
+            if (matchSectionName(line, section))
+            {
+                ++sections;
+                textSize += section.size();
+            }
+            else if (matchKeyValue(line, key, value))
+            {
+                ++keyValues;
+                textSize += key.size() + value.size();
+            }
+        }
+    }
+};
+
+class ScannerParser : public QLoaderParser
+{
+protected:
+    bool keyValue(QByteArrayView key, QByteArrayView value) override
+    {
+        ++keyValues;
+        textSize += key.size() + value.size();
+        return true;
+    }
+
+    bool section(QByteArrayView section) override
+    {
+        ++sections;
+        textSize += section.size();
+        return true;
+    }
+
+public:
+    qsizetype keyValues{};
+    qsizetype sections{};
+    qsizetype textSize{};
+};
+
+class tst_QLoaderLineScanner : public QObject
+{
+    Q_OBJECT
+
+    QByteArray data;
+    qsizetype textSize{};
+
+private Q_SLOTS:
+    void initTestCase();
+    void baseline();
+    void scanner();
+};
+
+void tst_QLoaderLineScanner::initTestCase()
+{
+    data = "#!/usr/bin/env qtloader6\n";
+    for (int i = 0; i < 10000; ++i)
+    {
+        data += "[App/Window/Item" + QByteArray::number(i) + "]\n";
+        data += "class = QLoaderTerminal\n";
+        data += "# geometry in pixels\n";
+        data += "geometry = @Rect(0 0 640 480)\n";
+        data += "text = a longer value with some spaces in it\n\n";
+    }
+
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+
+    BaselineParser parser;
+    parser.parse(&buffer);
+    textSize = parser.textSize;
+}
+
+void tst_QLoaderLineScanner::baseline()
+{
+    BaselineParser parser;
+
+    QBENCHMARK
+    {
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::ReadOnly);
+
+        parser = {};
+        parser.parse(&buffer);
+    }
+
+    QCOMPARE(parser.sections, 10000);
+    QCOMPARE(parser.keyValues, 30000);
+    QCOMPARE(parser.textSize, textSize);
+}
+
+void tst_QLoaderLineScanner::scanner()
+{
+    ScannerParser parser;
+
+    QBENCHMARK
+    {
+        parser.keyValues = parser.sections = parser.textSize = 0;
+        parser.parse(QByteArrayView(data));
+    }
+
+    QCOMPARE(parser.sections, 10000);
+    QCOMPARE(parser.keyValues, 30000);
+    QCOMPARE(parser.textSize, textSize);
+}
+
+QTEST_APPLESS_MAIN(tst_QLoaderLineScanner)
+
+#include "tst_bench_linescanner.moc"
@@ -0,0 +1,118 @@
+// Copyright (C) 2026 Sergey Naumov <sergey@naumov.io>
+// SPDX-License-Identifier: 0BSD
+
+#include "qloadervariantconverter_p.h"
+#include <QRegularExpression>
+#include <QTest>
+
+using namespace Qt::Literals::StringLiterals;
+
+class RegularExpressionConverter
+{
+    const QRegularExpression bytearray{u"^QByteArray\\s*\\(\\s*(.*)\\)"_s};
+
+    const QRegularExpression color_rgb{u"^QColor\\s*\\(\\s*(?<r>\\d+)\\s*\\,"
+                                       u"\\s*(?<g>\\d+)\\s*\\,"
+                                       u"\\s*(?<b>\\d+)\\s*\\)"_s};
+
+    const QRegularExpression color_rgba{u"^QColor\\s*\\(\\s*(?<r>\\d+)\\s*\\,"
+                                        u"\\s*(?<g>\\d+)\\s*\\,"
+                                        u"\\s*(?<b>\\d+)\\s*\\,"
+                                        u"\\s*(?<a>\\d+)\\s*\\)"_s};
+
+    const QRegularExpression size{u"^QSize\\s*\\(\\s*(?<width>\\d+)\\s*\\,\\s*(?<height>\\d+)\\s*\\)"_s};
+
+public:
+    QVariant fromString(const QString &value) const
+    {
+        if (value.at(0) != u'Q')
+            return value;
+
+        QStringView view(QStringView(value).sliced(1));
+        QRegularExpressionMatch match;
+
+        if (view.startsWith("ByteArray"_L1) && (match = bytearray.match(value)).hasMatch())
+            return QVariant::fromValue(QByteArray::fromBase64(match.capturedView(1).toLocal8Bit()));
+
+        if (view.startsWith("Color"_L1))
+        {
+            if ((match = color_rgb.match(value)).hasMatch())
+                return QColor(match.capturedView(u"r"_s).toInt(),
+                              match.capturedView(u"g"_s).toInt(),
+                              match.capturedView(u"b"_s).toInt());
+
+            if ((match = color_rgba.match(value)).hasMatch())
+                return QColor(match.capturedView(u"r"_s).toInt(),
+                              match.capturedView(u"g"_s).toInt(),
+                              match.capturedView(u"b"_s).toInt(),
+                              match.capturedView(u"a"_s).toInt());
+        }
+
+        if (view.startsWith("Size"_L1) && (match = size.match(value)).hasMatch())
+            return QSize(match.capturedView(u"width"_s).toInt(), match.capturedView(u"height"_s).toInt());
+
+        return value;
+    }
+};
+
+class tst_QLoaderVariantConverter : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void fromString_data();
+    void fromString();
+    void regularExpression_data();
+    void regularExpression();
+};
+
+void tst_QLoaderVariantConverter::fromString_data()
+{
+    QTest::addColumn<QString>("string");
+    QTest::addColumn<QVariant>("value");
+
+    QTest::newRow("QByteArray") << u"QByteArray(cXRsb2FkZXI=)"_s << QVariant(QByteArray("qtloader"));
+    QTest::newRow("QColor") << u"QColor(12, 34, 56)"_s << QVariant(QColor(12, 34, 56));
+    QTest::newRow("QColor alpha") << u"QColor(12, 34, 56, 78)"_s << QVariant(QColor(12, 34, 56, 78));
+    QTest::newRow("QSize") << u"QSize(640, 480)"_s << QVariant(QSize(640, 480));
+    QTest::newRow("QString") << u"Qt Loader"_s << QVariant(u"Qt Loader"_s);
+}
+
+void tst_QLoaderVariantConverter::fromString()
+{
+    QFETCH(QString, string);
+    QFETCH(QVariant, value);
+
+    QLoaderVariantConverter converter;
+    QVariant result;
+    QBENCHMARK
+    {
+        result = converter.fromString(string);
+    }
+
+    QCOMPARE(result, value);
+}
+
+void tst_QLoaderVariantConverter::regularExpression_data()
+{
+    fromString_data();
+}
+
+void tst_QLoaderVariantConverter::regularExpression()
+{
+    QFETCH(QString, string);
+    QFETCH(QVariant, value);
+
+    RegularExpressionConverter converter;
+    QVariant result;
+    QBENCHMARK
+    {
+        result = converter.fromString(string);
+    }
+
+    QCOMPARE(result, value);
+}
+
+QTEST_APPLESS_MAIN(tst_QLoaderVariantConverter)
+
+#include "tst_bench_variantconverter.moc"
@@ -0,0 +1,31 @@
+# Copyright (C) 2026 Sergey Naumov <sergey@naumov.io>
+# SPDX-License-Identifier: 0BSD
+
+# qt_loader_generate_tree(<target> <name> <file.qt6>)
+#
+# Compiles <file.qt6> into a C++ source with a constant QLoaderStaticTree
+# <name> and adds it to <target>. Declare it where it is used with
+# "extern const QLoaderStaticTree <name>;" and pass it to QLoaderTree.
+function(qt_loader_generate_tree target name file)
+    get_filename_component(input ${file} ABSOLUTE)
+    set(output ${CMAKE_CURRENT_BINARY_DIR}/${name}.cpp)
+
+    if(TARGET qtloader${QT_VERSION_MAJOR})
+        set(generator $<TARGET_FILE:qtloader${QT_VERSION_MAJOR}>)
+        set(depends qtloader${QT_VERSION_MAJOR})
+    else()
+        find_program(QT_LOADER_GENERATOR qtloader${QT_VERSION_MAJOR} REQUIRED)
+        set(generator ${QT_LOADER_GENERATOR})
+        set(depends ${QT_LOADER_GENERATOR})
+    endif()
+
+    add_custom_command(
+        OUTPUT ${output}
+        COMMAND ${generator} --generate ${output} --name ${name} ${input}
+        DEPENDS ${input} ${depends}
+        COMMENT "Generating ${name} from ${file}"
+        VERBATIM
+    )
+
+    target_sources(${target} PRIVATE ${output})
+endfunction()
@@ -0,0 +1,54 @@
+// Copyright (C) 2026 Sergey Naumov <sergey@naumov.io>
+// SPDX-License-Identifier: 0BSD
+
+#ifndef QLOADERARENA_P_H
+#define QLOADERARENA_P_H
+
+#include <QtGlobal>
+#include <memory>
+#include <vector>
+
+template<typename T, qsizetype BlockSize = 4096>
+class QLoaderArena
+{
+    Q_DISABLE_COPY_MOVE(QLoaderArena)
+
+    union Slot
+    {
+        Slot *next;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> blocks;
+    Slot *free{};
+    qsizetype used{BlockSize};
+
+public:
+    QLoaderArena() = default;
+
+    void *allocate()
+    {
+        if (Slot *slot = free)
+        {
+            free = slot->next;
+            return slot->storage;
+        }
+
+        if (used == BlockSize)
+        {
+            blocks.emplace_back(new Slot[BlockSize]);
+            used = 0;
+        }
+
+        return blocks.back()[used++].storage;
+    }
+
+    void deallocate(void *pointer)
+    {
+        Slot *slot = static_cast<Slot *>(pointer);
+        slot->next = free;
+        free = slot;
+    }
+};
+
+#endif // QLOADERARENA_P_H
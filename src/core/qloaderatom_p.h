@@ -0,0 +1,88 @@
+// Copyright (C) 2026 Sergey Naumov <sergey@naumov.io>
+// SPDX-License-Identifier: 0BSD
+
+#ifndef QLOADERATOM_P_H
+#define QLOADERATOM_P_H
+
+#include <QHash>
+#include <QVarLengthArray>
+
+class QLoaderAtomData
+{
+public:
+    const QByteArray utf8;
+};
+
+class QLoaderAtom
+{
+    const QLoaderAtomData *d{};
+
+public:
+    QLoaderAtom() = default;
+    explicit QLoaderAtom(const QLoaderAtomData *data)
+    :   d(data)
+    { }
+
+    bool isNull() const { return !d; }
+    QString toString() const { return d ? QString::fromUtf8(d->utf8) : QString(); }
+    QByteArray toUtf8() const { return d ? d->utf8 : QByteArray(); }
+    QByteArrayView view() const { return d ? QByteArrayView(d->utf8) : QByteArrayView(); }
+
+    friend bool operator==(QLoaderAtom lhs, QLoaderAtom rhs) { return lhs.d == rhs.d; }
+    friend bool operator<(QLoaderAtom lhs, QLoaderAtom rhs) { return lhs.d != rhs.d && lhs.view() < rhs.view(); }
+    friend size_t qHash(QLoaderAtom atom, size_t seed = 0) { return qHash(quintptr(atom.d), seed); }
+};
+
+class QLoaderAtomTable
+{
+    Q_DISABLE_COPY_MOVE(QLoaderAtomTable)
+
+    QHash<QByteArrayView, const QLoaderAtomData *> atoms;
+
+public:
+    template<typename Function>
+    static auto withUtf8(QStringView string, Function function)
+    {
+        QVarLengthArray<char, 128> ascii(string.size());
+        for (qsizetype i = 0; i < string.size(); ++i)
+        {
+            if (string[i].unicode() >= 0x80)
+                return function(QByteArrayView(string.toUtf8()));
+
+            ascii[i] = char(string[i].unicode());
+        }
+
+        return function(QByteArrayView(ascii.data(), ascii.size()));
+    }
+
+    QLoaderAtomTable() = default;
+    ~QLoaderAtomTable() { qDeleteAll(atoms); }
+
+    QLoaderAtom find(QByteArrayView utf8) const
+    {
+        return QLoaderAtom(atoms.value(utf8));
+    }
+
+    QLoaderAtom find(QStringView string) const
+    {
+        return withUtf8(string, [this](QByteArrayView utf8) { return find(utf8); });
+    }
+
+    QLoaderAtom insert(QByteArrayView utf8)
+    {
+        if (const QLoaderAtomData *data = atoms.value(utf8))
+            return QLoaderAtom(data);
+
+        const QLoaderAtomData *data = new QLoaderAtomData{utf8.toByteArray()};
+        atoms.insert(data->utf8, data);
+
+        return QLoaderAtom(data);
+    }
+
+    QLoaderAtom insert(QStringView string)
+    {
+        return withUtf8(string, [this](QByteArrayView utf8) { return insert(utf8); });
+    }
+};
+
+#endif // QLOADERATOM_P_H
@@ -0,0 +1,33 @@
+// Copyright (C) 2026 Sergey Naumov <sergey@naumov.io>
+// SPDX-License-Identifier: 0BSD
+
+#ifndef QLOADERCHANGE_H
+#define QLOADERCHANGE_H
+
+#include "qtloaderglobal.h"
+#include "qloadersectionhandle.h"
+#include <QtCore/qmetatype.h>
+
+class Q_LOADER_EXPORT QLoaderChange
+{
+    Q_GADGET
+
+public:
+    enum Kind
+    {
+        Value,
+        Add,
+        Remove,
+        Move,
+        Copy
+    };
+    Q_ENUM(Kind)
+
+    Kind kind{};
+    QString section{};
+    QString key{};
+    QString from{};
+    QLoaderSectionHandle handle{};
+};
+
+#endif // QLOADERCHANGE_H
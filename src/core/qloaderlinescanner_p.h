@@ -0,0 +1,141 @@
+// Copyright (C) 2026 Sergey Naumov <sergey@naumov.io>
+// SPDX-License-Identifier: 0BSD
+
+#ifndef QLOADERLINESCANNER_P_H
+#define QLOADERLINESCANNER_P_H
+
+#include <QByteArrayView>
+#include <QtAlgorithms>
+
+#if defined(__AVX2__)
+#  define QLOADER_LINESCANNER_AVX2
+#  include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#  define QLOADER_LINESCANNER_SSE2
+#  include <emmintrin.h>
+#endif
+
+class QLoaderLine
+{
+public:
+    QByteArrayView text;
+    qsizetype first{-1};
+    qsizetype last{};
+    qsizetype equal{-1};
+    qsizetype comment{-1};
+    qsizetype firstOpen{-1};
+    qsizetype lastOpen{-1};
+    qsizetype firstClose{-1};
+    qsizetype lastClose{-1};
+};
+
+class QLoaderLineScanner
+{
+    static void first(qsizetype &index, qsizetype offset, quint32 mask)
+    {
+        if (mask && index == -1)
+            index = offset + qCountTrailingZeroBits(mask);
+    }
+
+    static void last(qsizetype &index, qsizetype offset, quint32 mask)
+    {
+        if (mask)
+            index = offset + 31 - qCountLeadingZeroBits(mask);
+    }
+
+    static qsizetype block(QLoaderLine &line, qsizetype offset,
+                           quint32 newline, quint32 equal, quint32 comment,
+                           quint32 open, quint32 close, quint32 text)
+    {
+        if (newline)
+        {
+            const quint32 before = (quint32(1) << qCountTrailingZeroBits(newline)) - 1;
+            equal &= before;
+            comment &= before;
+            open &= before;
+            close &= before;
+            text &= before;
+        }
+
+        first(line.equal, offset, equal);
+        first(line.comment, offset, comment);
+        first(line.firstOpen, offset, open);
+        last(line.lastOpen, offset, open);
+        first(line.firstClose, offset, close);
+        last(line.lastClose, offset, close);
+        first(line.first, offset, text);
+        if (text)
+            line.last = offset + 32 - qCountLeadingZeroBits(text);
+
+        return newline ? offset + qCountTrailingZeroBits(newline) : -1;
+    }
+
+public:
+    static bool isSpace(char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+    static QLoaderLine next(QByteArrayView data, qsizetype &lineStart)
+    {
+        QLoaderLine line;
+        const char *begin = data.data() + lineStart;
+        const qsizetype size = data.size() - lineStart;
+        qsizetype end = -1;
+        qsizetype i{};
+
+#if defined(QLOADER_LINESCANNER_AVX2)
+        for (; end == -1 && i + 32 <= size; i += 32)
+        {
+            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin + i));
+            const __m256i shifted = _mm256_sub_epi8(chunk, _mm256_set1_epi8('\t'));
+            auto match = [&chunk](char c)
+            {
+                return quint32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(c))));
+            };
+
+            const quint32 space = match(' ') |
+                quint32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8(4)),
+                                                               shifted)));
+
+            end = block(line, i, match('\n'), match('='), match('#'), match('['), match(']'), ~space);
+        }
+#elif defined(QLOADER_LINESCANNER_SSE2)
+        for (; end == -1 && i + 16 <= size; i += 16)
+        {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin + i));
+            const __m128i shifted = _mm_sub_epi8(chunk, _mm_set1_epi8('\t'));
+            auto match = [&chunk](char c)
+            {
+                return quint32(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(c))));
+            };
+
+            const quint32 space = match(' ') |
+                quint32(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(4)), shifted)));
+
+            end = block(line, i, match('\n'), match('='), match('#'), match('['), match(']'), ~space & 0xffff);
+        }
+#endif
+        for (; end == -1 && i < size; ++i)
+        {
+            const char c = begin[i];
+            if (c == '\n')
+                end = i;
+            else
+                block(line, i, 0, c == '=', c == '#', c == '[', c == ']', !isSpace(c));
+        }
+
+        if (end == -1)
+            end = size;
+
+        lineStart += end + 1;
+        line.text = QByteArrayView(begin, end);
+
+        if (line.text.endsWith('\r'))
+            line.text.chop(1);
+
+        if (line.first == -1)
+            line.first = 0;
+
+        return line;
+    }
+};
+
+#endif // QLOADERLINESCANNER_P_H
@@ -0,0 +1,166 @@
+// Copyright (C) 2026 Sergey Naumov <sergey@naumov.io>
+// SPDX-License-Identifier: 0BSD
+
+#include "qloaderparser.h"
+#include "qloaderlinescanner_p.h"
+#include <QFileDevice>
+
+static bool matchSectionName(const QLoaderLine &line, QByteArrayView &section)
+{
+    const qsizetype size = line.text.size();
+
+    if (size > 2 &&
+        line.firstOpen == 0 &&
+        line.lastOpen == 0 &&
+        line.firstClose == size - 1 &&
+        line.lastClose == size - 1)
+    {
+        section = line.text.sliced(1, size - 2);
+        return true;
+    }
+
+    return false;
+}
+
+static bool matchKeyValue(const QLoaderLine &line, QByteArrayView &key, QByteArrayView &value)
+{
+    if (line.equal > 0 && line.first < line.equal)
+    {
+        qsizetype keyEnd = line.equal;
+        while (QLoaderLineScanner::isSpace(line.text[keyEnd - 1]))
+            --keyEnd;
+
+        qsizetype valueStart = line.equal + 1;
+        while (valueStart < line.last && QLoaderLineScanner::isSpace(line.text[valueStart]))
+            ++valueStart;
+
+        key = line.text.sliced(line.first, keyEnd - line.first);
+        value = line.text.sliced(valueStart, line.last - valueStart);
+        return true;
+    }
+
+    return false;
+}
+
+class QLoaderParserPrivate
+{
+public:
+    QLoaderParser *const q_ptr;
+    int line{};
+    qint64 offset{};
+    qint64 position{};
+
+    QLoaderParserPrivate(QLoaderParser *q)
+    :   q_ptr(q)
+    { }
+
+    bool read(QByteArrayView data)
+    {
+        if (!line && data.startsWith("\xEF\xBB\xBF"))
+        {
+            data = data.sliced(3);
+            position += 3;
+        }
+
+        qsizetype lineStart{};
+        while (lineStart < data.size())
+        {
+            offset = position + lineStart;
+            if (!readLine(QLoaderLineScanner::next(data, lineStart)))
+                return false;
+        }
+
+        position += data.size();
+
+        return true;
+    }
+
+    bool readLine(const QLoaderLine &text)
+    {
+        if (++line == 1 && text.text.startsWith("#!"))
+            return q_ptr->shebang(text.text);
+
+        if (text.text.isEmpty() || text.comment == 0)
+            return true;
+
+        QByteArrayView key, value;
+        if (matchSectionName(text, key))
+            return q_ptr->section(key);
+
+        if (matchKeyValue(text, key, value))
+            return q_ptr->keyValue(key, value);
+
+        return q_ptr->error(text.text);
+    }
+};
+
+QLoaderParser::QLoaderParser()
+:   d_ptr(new QLoaderParserPrivate(this))
+{ }
+
+QLoaderParser::~QLoaderParser()
+{ }
+
+bool QLoaderParser::error(QByteArrayView)
+{
+    return false;
+}
+
+bool QLoaderParser::keyValue(QByteArrayView, QByteArrayView)
+{
+    return true;
+}
+
+int QLoaderParser::lineNumber() const
+{
+    return d_ptr->line;
+}
+
+qint64 QLoaderParser::lineOffset() const
+{
+    return d_ptr->offset;
+}
+
+bool QLoaderParser::parse(QByteArrayView data)
+{
+    d_ptr->line = 0;
+    d_ptr->position = 0;
+
+    return d_ptr->read(data);
+}
+
+bool QLoaderParser::parse(QIODevice *device)
+{
+    d_ptr->line = 0;
+    d_ptr->position = (device->isSequential() ? 0 : device->pos());
+
+    if (QFileDevice *file = qobject_cast<QFileDevice *>(device))
+    {
+        const qint64 size = file->size() - d_ptr->position;
+        if (uchar *map = size > 0 ? file->map(d_ptr->position, size) : nullptr)
+        {
+            bool ok = d_ptr->read(QByteArrayView(map, size));
+            file->unmap(map);
+
+            return ok;
+        }
+    }
+
+    while (!device->atEnd())
+    {
+        if (!d_ptr->read(device->readLine()))
+            return false;
+    }
+
+    return true;
+}
+
+bool QLoaderParser::section(QByteArrayView)
+{
+    return true;
+}
+
+bool QLoaderParser::shebang(QByteArrayView)
+{
+    return true;
+}
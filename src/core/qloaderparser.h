@@ -0,0 +1,38 @@
+// Copyright (C) 2026 Sergey Naumov <sergey@naumov.io>
+// SPDX-License-Identifier: 0BSD
+
+#ifndef QLOADERPARSER_H
+#define QLOADERPARSER_H
+
+#include "qtloaderglobal.h"
+#include <QByteArrayView>
+#include <QScopedPointer>
+
+class QIODevice;
+class QLoaderParserPrivate;
+
+class Q_LOADER_EXPORT QLoaderParser
+{
+    Q_DISABLE_COPY(QLoaderParser)
+
+    friend class QLoaderParserPrivate;
+
+    const QScopedPointer<QLoaderParserPrivate> d_ptr;
+
+protected:
+    virtual bool error(QByteArrayView text);
+    virtual bool keyValue(QByteArrayView key, QByteArrayView value);
+    virtual bool section(QByteArrayView section);
+    virtual bool shebang(QByteArrayView line);
+
+public:
+    QLoaderParser();
+    virtual ~QLoaderParser();
+
+    int lineNumber() const;
+    qint64 lineOffset() const;
+    bool parse(QByteArrayView data);
+    bool parse(QIODevice *device);
+};
+
+#endif // QLOADERPARSER_H
@@ -0,0 +1,241 @@
+// Copyright (C) 2026 Sergey Naumov <sergey@naumov.io>
+// SPDX-License-Identifier: 0BSD
+
+#ifndef QLOADERPROPERTYMAP_P_H
+#define QLOADERPROPERTYMAP_P_H
+
+#include "qloaderatom_p.h"
+#include <QVarLengthArray>
+#include <QVariant>
+#include <algorithm>
+#include <atomic>
+#include <typeinfo>
+
+class QLoaderProperty
+{
+    enum State
+    {
+        Empty,
+        Busy,
+        Ready
+    };
+
+    class Cache
+    {
+    public:
+        std::atomic<int> references{1};
+        std::atomic<int> state{Empty};
+        const std::type_info *converter{};
+        QVariant variant;
+    };
+
+    mutable std::atomic<Cache *> cache{};
+
+    static Cache *share(Cache *cache)
+    {
+        if (cache)
+            cache->references.fetch_add(1, std::memory_order_relaxed);
+
+        return cache;
+    }
+
+    static void release(Cache *cache)
+    {
+        if (cache && cache->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete cache;
+    }
+
+public:
+    QByteArray utf8;
+
+    QLoaderProperty() = default;
+    QLoaderProperty(const QByteArray &utf8)
+    :   utf8(utf8)
+    { }
+
+    QLoaderProperty(const QLoaderProperty &other)
+    :   cache(share(other.cache.load(std::memory_order_acquire))),
+        utf8(other.utf8)
+    { }
+
+    QLoaderProperty(QLoaderProperty &&other) noexcept
+    :   cache(other.cache.exchange(nullptr)),
+        utf8(std::move(other.utf8))
+    { }
+
+    ~QLoaderProperty()
+    {
+        release(cache.load());
+    }
+
+    QLoaderProperty &operator=(const QLoaderProperty &other)
+    {
+        if (this != &other)
+        {
+            release(cache.exchange(share(other.cache.load(std::memory_order_acquire))));
+            utf8 = other.utf8;
+        }
+
+        return *this;
+    }
+
+    QLoaderProperty &operator=(QLoaderProperty &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release(cache.exchange(other.cache.exchange(nullptr)));
+            utf8 = std::move(other.utf8);
+        }
+
+        return *this;
+    }
+
+    QLoaderProperty &operator=(const QByteArray &value)
+    {
+        release(cache.exchange(nullptr));
+        utf8 = value;
+
+        return *this;
+    }
+
+    QLoaderProperty decoding() const
+    {
+        if (!cache.load(std::memory_order_acquire))
+        {
+            Cache *expected{};
+            Cache *created = new Cache;
+            if (!cache.compare_exchange_strong(expected, created, std::memory_order_acq_rel))
+                delete created;
+        }
+
+        return *this;
+    }
+
+    template<typename Function>
+    QVariant toVariant(const std::type_info &converter, Function decode) const
+    {
+        Cache *shared = cache.load(std::memory_order_acquire);
+        if (shared && shared->state.load(std::memory_order_acquire) == Ready && *shared->converter == converter)
+            return shared->variant;
+
+        QVariant decoded = decode();
+
+        int expected = Empty;
+        if (shared && shared->state.compare_exchange_strong(expected, Busy, std::memory_order_acquire))
+        {
+            shared->converter = &converter;
+            shared->variant = decoded;
+            shared->state.store(Ready, std::memory_order_release);
+        }
+
+        return decoded;
+    }
+};
+
+class QLoaderPropertyMap
+{
+    class Entry
+    {
+    public:
+        QLoaderAtom key;
+        QLoaderProperty value;
+    };
+
+    QVarLengthArray<Entry, 4> entries;
+
+    Entry *find(QLoaderAtom key)
+    {
+        for (Entry &entry : entries)
+        {
+            if (entry.key == key)
+                return &entry;
+        }
+
+        return nullptr;
+    }
+
+    Entry *lowerBound(QLoaderAtom key)
+    {
+        return std::lower_bound(entries.begin(), entries.end(), key,
+                                [](const Entry &entry, QLoaderAtom key) { return entry.key.view() < key.view(); });
+    }
+
+public:
+    class const_iterator
+    {
+        const Entry *entry;
+
+    public:
+        explicit const_iterator(const Entry *entry)
+        :   entry(entry)
+        { }
+
+        QLoaderAtom key() const { return entry->key; }
+        const QByteArray &value() const { return entry->value.utf8; }
+        const QLoaderProperty &operator*() const { return entry->value; }
+
+        const_iterator &operator++() { ++entry; return *this; }
+        friend bool operator==(const_iterator lhs, const_iterator rhs) { return lhs.entry == rhs.entry; }
+    };
+
+    const_iterator cbegin() const { return const_iterator(entries.cbegin()); }
+    const_iterator cend() const { return const_iterator(entries.cend()); }
+    void clear() { entries.clear(); }
+    bool contains(QLoaderAtom key) const { return constFind(key) != cend(); }
+    qsizetype size() const { return entries.size(); }
+
+    const_iterator constFind(QLoaderAtom key) const
+    {
+        for (const Entry &entry : entries)
+        {
+            if (entry.key == key)
+                return const_iterator(&entry);
+        }
+
+        return cend();
+    }
+
+    const_iterator constFind(QByteArrayView key) const
+    {
+        const Entry *entry = std::lower_bound(entries.cbegin(), entries.cend(), key,
+                                              [](const Entry &entry, QByteArrayView key) { return entry.key.view() < key; });
+
+        return (entry != entries.cend() && entry->key.view() == key ? const_iterator(entry) : cend());
+    }
+
+    void insert(QLoaderAtom key, const QByteArray &value)
+    {
+        if (Entry *entry = find(key))
+            entry->value = value;
+        else
+            entries.insert(lowerBound(key), Entry{key, value});
+    }
+
+    qint64 release()
+    {
+        qint64 size = (entries.capacity() > 4 ? entries.capacity() * qint64(sizeof(Entry)) : 0);
+        for (const Entry &entry : entries)
+        {
+            if (entry.value.utf8.isDetached())
+                size += entry.value.utf8.capacity();
+        }
+
+        entries.clear();
+        entries.squeeze();
+
+        return size;
+    }
+
+    bool remove(QLoaderAtom key)
+    {
+        if (Entry *entry = find(key))
+        {
+            entries.erase(entry);
+            return true;
+        }
+
+        return false;
+    }
+};
+
+#endif // QLOADERPROPERTYMAP_P_H
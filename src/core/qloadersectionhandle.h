@@ -0,0 +1,35 @@
+// Copyright (C) 2026 Sergey Naumov <sergey@naumov.io>
+// SPDX-License-Identifier: 0BSD
+
+#ifndef QLOADERSECTIONHANDLE_H
+#define QLOADERSECTIONHANDLE_H
+
+#include "qtloaderglobal.h"
+#include <QtCore/qhashfunctions.h>
+
+class QLoaderSectionHandle
+{
+    friend class QLoaderTree;
+    friend class QLoaderTreePrivate;
+
+    int node{-1};
+    quint32 generation{};
+
+    QLoaderSectionHandle(int index, quint32 count)
+    :   node(index),
+        generation(count)
+    { }
+
+public:
+    QLoaderSectionHandle() = default;
+
+    bool isNull() const { return node == -1; }
+
+    friend bool operator==(const QLoaderSectionHandle &, const QLoaderSectionHandle &) = default;
+    friend size_t qHash(const QLoaderSectionHandle &handle, size_t seed = 0)
+    {
+        return qHashMulti(seed, handle.node, handle.generation);
+    }
+};
+
+#endif // QLOADERSECTIONHANDLE_H
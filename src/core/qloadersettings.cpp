@@ -4,28 +4,41 @@
 #include "qloadersettings.h"
 #include "qloadertree.h"
 #include "qloadertree_p.h"
+#include <algorithm>
 
 using namespace Qt::Literals::StringLiterals;
 
+static const QLoaderProperty *snapshotProperty(const QLoaderSnapshot &snapshot, int node, QStringView key)
+{
+    return QLoaderAtomTable::withUtf8(key, [&snapshot, node](QByteArrayView utf8)
+    {
+        return snapshot.property(node, utf8);
+    });
+}
+
 QLoaderSettings::QLoaderSettings(QLoaderTreePrivate &d)
 :   q_ptr(this),
-    d_ptr(&d)
+    d_ptr(&d),
+    node(d.insertNode(this))
 { }
 
 QLoaderSettings::QLoaderSettings(QObject *object, QLoaderSettings *settings, LoadHints loadHints)
 :   q_ptr(settings->q_ptr),
-    d_ptr(settings->d_ptr)
+    d_ptr(settings->d_ptr),
+    node(settings->node)
 {
     Q_UNUSED(loadHints)
 
     d_ptr->mutex.lock();
-    if (!d_ptr->hash.data[q_ptr].object)
+    if (!d_ptr->nodes.data[node].object)
     {
-        d_ptr->hash.data[q_ptr].object = object;
-        d_ptr->hash.settings.objects[object] = this;
-        d_ptr->setProperties(d_ptr->hash.data[q_ptr], object);
+        d_ptr->nodes.data[node].object = object;
+        d_ptr->nodes.objects[object] = this;
+        d_ptr->setProperties(d_ptr->nodes.data[node], object);
+        d_ptr->resetSnapshot(node);
+        d_ptr->publishSnapshot();
     }
-    d_ptr->hash.data[q_ptr].settings.append(this);
+    d_ptr->nodes.data[node].settings.append(this);
     d_ptr->mutex.unlock();
 }
 
@@ -35,28 +48,20 @@ QLoaderSettings::~QLoaderSettings()
     {
         bool removeLastInstance{};
         d_ptr->mutex.lock();
-        if (d_ptr->hash.data[q_ptr].settings.removeOne(this))
+        if (d_ptr->nodes.data[node].settings.removeOne(this))
         {
-            QHash<QLoaderSettings*, QLoaderSettingsData> &data = d_ptr->hash.data;
-            const QLoaderSettingsData &item = data[q_ptr];
-
-            if ((removeLastInstance = item.settings.isEmpty()))
+            if ((removeLastInstance = d_ptr->nodes.data[node].settings.isEmpty()))
             {
-                if (data.contains(item.parent))
-                    data[item.parent].children.removeOne(q_ptr);
-
-                d_ptr->hash.settings.sections.remove(item.section);
-                d_ptr->hash.settings.objects.remove(item.object);
-                data.remove(q_ptr);
+                d_ptr->changed(QLoaderChange::Remove, q_ptr);
+                d_ptr->deleteSettings(q_ptr);
+                d_ptr->publishSnapshot();
                 d_ptr->modified = true;
-
-                delete q_ptr;
             }
         }
         d_ptr->mutex.unlock();
 
         if (removeLastInstance)
-            emit d_ptr->q_ptr->settingsChanged();
+            d_ptr->notify();
     }
 }
 
@@ -65,7 +70,7 @@ void QLoaderSettings::emitError(const QString &error) const
     if (d_ptr->loaded)
     {
         d_ptr->mutex.lock();
-        QObject *object = d_ptr->hash.data[q_ptr].object;
+        QObject *object = d_ptr->nodes.data[node].object;
         d_ptr->mutex.unlock();
         emit d_ptr->q_ptr->errorChanged(object, error);
     }
@@ -82,7 +87,7 @@ void QLoaderSettings::emitInfo(const QString &info) const
     if (d_ptr->loaded)
     {
         d_ptr->mutex.lock();
-        QObject *object = d_ptr->hash.data[q_ptr].object;
+        QObject *object = d_ptr->nodes.data[node].object;
         d_ptr->mutex.unlock();
         emit d_ptr->q_ptr->infoChanged(object, info);
     }
@@ -99,7 +104,7 @@ void QLoaderSettings::emitWarning(const QString &warning) const
     if (d_ptr->loaded)
     {
         d_ptr->mutex.lock();
-        QObject *object = d_ptr->hash.data[q_ptr].object;
+        QObject *object = d_ptr->nodes.data[node].object;
         d_ptr->mutex.unlock();
         emit d_ptr->q_ptr->warningChanged(object, warning);
     }
@@ -121,20 +126,140 @@ QString QLoaderSettings::fromVariant(const QVariant &variant) const
     return d_ptr->fromVariant(variant);
 }
 
+bool QLoaderSettings::parse(QStringView key, bool &value) const
+{
+    QByteArray utf8;
+    if (!readUtf8(key, utf8))
+        return false;
+
+    utf8 = utf8.trimmed();
+    value = !(utf8.isEmpty() || utf8 == "0" || !utf8.compare("false", Qt::CaseInsensitive));
+    return true;
+}
+
+bool QLoaderSettings::parse(QStringView key, double &value) const
+{
+    bool ok{};
+    QByteArray utf8;
+    if (readUtf8(key, utf8))
+        value = utf8.toDouble(&ok);
+
+    return ok;
+}
+
+bool QLoaderSettings::parse(QStringView key, int &value) const
+{
+    bool ok{};
+    QByteArray utf8;
+    if (readUtf8(key, utf8))
+        value = utf8.toInt(&ok);
+
+    return ok;
+}
+
+bool QLoaderSettings::parse(QStringView key, qint64 &value) const
+{
+    bool ok{};
+    QByteArray utf8;
+    if (readUtf8(key, utf8))
+        value = utf8.toLongLong(&ok);
+
+    return ok;
+}
+
+bool QLoaderSettings::parse(QStringView key, QString &value) const
+{
+    QByteArray utf8;
+    if (!readUtf8(key, utf8))
+        return false;
+
+    value = QString::fromUtf8(utf8);
+    return true;
+}
+
+bool QLoaderSettings::parse(QStringView key, uint &value) const
+{
+    bool ok{};
+    QByteArray utf8;
+    if (readUtf8(key, utf8))
+        value = utf8.toUInt(&ok);
+
+    return ok;
+}
+
+bool QLoaderSettings::parse(QStringView key, quint64 &value) const
+{
+    bool ok{};
+    QByteArray utf8;
+    if (readUtf8(key, utf8))
+        value = utf8.toULongLong(&ok);
+
+    return ok;
+}
+
+bool QLoaderSettings::readUtf8(QStringView key, QByteArray &utf8) const
+{
+    if (QLoaderSnapshotReader snapshot(*d_ptr); snapshot.contains(node))
+    {
+        const QLoaderProperty *property = snapshotProperty(*snapshot, node, key);
+        if (property)
+            utf8 = property->utf8;
+
+        return property;
+    }
+
+    QMutexLocker locker(&d_ptr->mutex);
+    const QLoaderProperty *property = d_ptr->property(d_ptr->nodes.data[node], d_ptr->atoms.find(key));
+    if (property)
+        utf8 = property->utf8;
+
+    return property;
+}
+
 bool QLoaderSettings::setValue(const QString &key, const QVariant &value)
 {
     d_ptr->mutex.lock();
-    bool contains = d_ptr->hash.data[q_ptr].properties.contains(key);
-    QString string = fromVariant(value);
-    if (!contains || d_ptr->hash.data[q_ptr].properties.value(key) != string)
+    if (d_ptr->nodes.data[node].included)
     {
-        if (contains && value.isNull())
-            d_ptr->hash.data[q_ptr].properties.remove(key);
-        else if (!value.isNull())
-            d_ptr->hash.data[q_ptr].properties[key] = string;
+        QMetaObject::invokeMethod(d_ptr->q_ptr, [q = d_ptr->q_ptr, object = d_ptr->nodes.data[node].object]
+        {
+            emit q->errorChanged(object, u"section read-only: included"_s);
+        }, Qt::QueuedConnection);
 
         d_ptr->mutex.unlock();
-        emit d_ptr->q_ptr->settingsChanged();
+        return false;
+    }
+
+    if (!d_ptr->materialize(d_ptr->nodes.data[node]))
+    {
+        d_ptr->mutex.unlock();
+        return false;
+    }
+
+    QLoaderAtom atom = d_ptr->atoms.find(key);
+    const QLoaderProperty *property = d_ptr->property(d_ptr->nodes.data[node], atom);
+    bool contains = d_ptr->nodes.data[node].properties.contains(atom);
+    QByteArray string = fromVariant(value).toUtf8();
+    if (value.isNull() ? contains : (!property || property->utf8 != string))
+    {
+        QLoaderChange::Kind kind = (contains ? QLoaderChange::Value : QLoaderChange::Add);
+        if (value.isNull())
+        {
+            d_ptr->nodes.data[node].properties.remove(atom);
+            if (!d_ptr->property(d_ptr->nodes.data[node], atom))
+                kind = QLoaderChange::Remove;
+        }
+        else
+            d_ptr->nodes.data[node].properties.insert(d_ptr->atoms.insert(key), string);
+
+        d_ptr->nodes.data[node].changed = true;
+        d_ptr->nodes.data[node].views.clear();
+        d_ptr->resetSnapshot(node);
+        d_ptr->publishSnapshot();
+        d_ptr->changed(kind, q_ptr, key);
+
+        d_ptr->mutex.unlock();
+        d_ptr->notify();
         return true;
     }
     d_ptr->mutex.unlock();
@@ -144,14 +269,20 @@ bool QLoaderSettings::setValue(const QString &key, const QVariant &value)
 
 bool QLoaderSettings::contains(const QString &key) const
 {
+    if (QLoaderSnapshotReader snapshot(*d_ptr); snapshot.contains(node))
+        return snapshotProperty(*snapshot, node, key);
+
     QMutexLocker locker(&d_ptr->mutex);
-    return d_ptr->hash.data[q_ptr].properties.contains(key);
+    return d_ptr->property(d_ptr->nodes.data[node], d_ptr->atoms.find(key));
 }
 
 const char *QLoaderSettings::className() const
 {
+    if (QLoaderSnapshotReader snapshot(*d_ptr); snapshot.contains(node))
+        return snapshot->node(node)->className.data();
+
     d_ptr->mutex.lock();
-    const char *name = d_ptr->hash.data[q_ptr].className.data();
+    const char *name = d_ptr->nodes.data[node].className.data();
     d_ptr->mutex.unlock();
 
     return name;
@@ -176,14 +307,20 @@ bool QLoaderSettings::isMovable(QStringView) const
 
 QString QLoaderSettings::pluginName() const
 {
+    if (QLoaderSnapshotReader snapshot(*d_ptr); snapshot.contains(node))
+        return snapshot->node(node)->pluginName;
+
     QMutexLocker locker(&d_ptr->mutex);
-    return  d_ptr->hash.data[q_ptr].pluginName;
+    return  d_ptr->nodes.data[node].pluginName;
 }
 
 QString QLoaderSettings::section() const
 {
+    if (QLoaderSnapshotReader snapshot(*d_ptr); snapshot.contains(node))
+        return snapshot->section(node);
+
     QMutexLocker locker(&d_ptr->mutex);
-    return d_ptr->hash.data[q_ptr].section;
+    return d_ptr->section(q_ptr);
 }
 
 QLoaderTree *QLoaderSettings::tree() const
@@ -193,11 +330,55 @@ QLoaderTree *QLoaderSettings::tree() const
 
 QVariant QLoaderSettings::value(const QString &key, const QVariant &defaultValue) const
 {
-    d_ptr->mutex.lock();
-    QVariant variant = defaultValue;
-    if (d_ptr->hash.data[q_ptr].properties.contains(key))
-        variant = fromString(d_ptr->hash.data[q_ptr].properties.value(key));
-    d_ptr->mutex.unlock();
+    QVariant result = variant(key);
+    return result.isValid() ? result : defaultValue;
+}
+
+QVariant QLoaderSettings::variant(QStringView key) const
+{
+    std::optional<QLoaderProperty> property;
+    if (QLoaderSnapshotReader snapshot(*d_ptr); snapshot.contains(node))
+    {
+        if (const QLoaderProperty *found = snapshotProperty(*snapshot, node, key))
+            property = found->decoding();
+    }
+    else
+    {
+        QMutexLocker locker(&d_ptr->mutex);
+        if (const QLoaderProperty *found = d_ptr->property(d_ptr->nodes.data[node], d_ptr->atoms.find(key)))
+            property = found->decoding();
+    }
+
+    if (!property)
+        return QVariant();
+
+    return property->toVariant(typeid(*this), [this, &property]
+                               { return fromString(QString::fromUtf8(property->utf8)); });
+}
+
+static QUtf8StringView utf8View(const QByteArray &utf8)
+{
+    return utf8.isNull() ? QUtf8StringView("") : QUtf8StringView(utf8.constData(), utf8.size());
+}
+
+QUtf8StringView QLoaderSettings::view(QStringView key) const
+{
+    if (QLoaderSnapshotReader snapshot(*d_ptr); snapshot.contains(node))
+    {
+        const QLoaderProperty *property = snapshotProperty(*snapshot, node, key);
+        return property ? utf8View(property->utf8) : QUtf8StringView();
+    }
+
+    QMutexLocker locker(&d_ptr->mutex);
+    QLoaderSettingsData &item = d_ptr->nodes.data[node];
+    const QLoaderProperty *property = d_ptr->property(item, d_ptr->atoms.find(key));
+    if (!property)
+        return QUtf8StringView();
+
+    const QByteArray &utf8 = property->utf8;
+    if (!utf8.isNull() && std::none_of(item.views.cbegin(), item.views.cend(), [&utf8](const QByteArray &view)
+                                       { return view.constData() == utf8.constData(); }))
+        item.views.append(utf8);
 
-    return variant;
+    return utf8View(utf8);
 }
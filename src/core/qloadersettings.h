@@ -6,6 +6,7 @@
 
 #include "qtloaderglobal.h"
 #include <QVariant>
+#include <type_traits>
 
 class QLoaderTreePrivate;
 class QLoaderTree;
@@ -18,9 +19,20 @@ class Q_LOADER_EXPORT QLoaderSettings
 
     QLoaderSettings *const q_ptr;
     QLoaderTreePrivate *const d_ptr;
+    const int node;
 
     QLoaderSettings(QLoaderTreePrivate &d);
 
+    bool parse(QStringView key, bool &value) const;
+    bool parse(QStringView key, double &value) const;
+    bool parse(QStringView key, int &value) const;
+    bool parse(QStringView key, qint64 &value) const;
+    bool parse(QStringView key, QString &value) const;
+    bool parse(QStringView key, uint &value) const;
+    bool parse(QStringView key, quint64 &value) const;
+    bool readUtf8(QStringView key, QByteArray &utf8) const;
+    QVariant variant(QStringView key) const;
+
 public:
     enum LoadHint
     {
@@ -53,6 +65,24 @@ public:
     QString section() const;
     QLoaderTree *tree() const;
     QVariant value(const QString &key, const QVariant &defaultValue = QVariant()) const;
+    // The view shares the stored UTF-8 value and stays valid until this
+    // section is next written or removed; copy it to keep it longer.
+    QUtf8StringView view(QStringView key) const;
+
+    template<typename T>
+    T value(QStringView key, const std::type_identity_t<T> &defaultValue = T()) const
+    {
+        if constexpr (requires (T &result) { parse(key, result); })
+        {
+            T result;
+            return parse(key, result) ? result : defaultValue;
+        }
+        else
+        {
+            QVariant result = variant(key);
+            return result.isValid() ? result.value<T>() : defaultValue;
+        }
+    }
 };
 
 #endif // QLOADERSETTINGS_H
@@ -0,0 +1,32 @@
+// Copyright (C) 2026 Sergey Naumov <sergey@naumov.io>
+// SPDX-License-Identifier: 0BSD
+
+#include "qloaderstatictree.h"
+
+QLoaderStaticSection::Factory QLoaderStaticSection::factoryOf(QByteArrayView className)
+{
+    if (!className.startsWith("QLoader"))
+        return External;
+
+    QByteArrayView shortName = className.sliced(7);
+
+    if (shortName == "ShellCd")
+        return ShellCd;
+
+    if (shortName == "ShellExit")
+        return ShellExit;
+
+    if (shortName == "ShellSave")
+        return ShellSave;
+
+    if (shortName == "Shell")
+        return Shell;
+
+    if (shortName == "Terminal")
+        return Terminal;
+
+    if (shortName == "MarkupEditor")
+        return MarkupEditor;
+
+    return NotFound;
+}
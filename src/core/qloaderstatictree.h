@@ -0,0 +1,53 @@
+// Copyright (C) 2026 Sergey Naumov <sergey@naumov.io>
+// SPDX-License-Identifier: 0BSD
+
+#ifndef QLOADERSTATICTREE_H
+#define QLOADERSTATICTREE_H
+
+#include "qtloaderglobal.h"
+#include <QByteArrayView>
+
+class QLoaderStaticProperty
+{
+public:
+    int line;
+    QByteArrayView key;
+    QByteArrayView value;
+};
+
+class Q_LOADER_EXPORT QLoaderStaticSection
+{
+public:
+    enum Factory : qint8
+    {
+        Unresolved,
+        External,
+        Shell,
+        ShellCd,
+        ShellExit,
+        ShellSave,
+        Terminal,
+        MarkupEditor,
+        NotFound
+    };
+
+    int line;
+    QByteArrayView section;
+    Factory factory;
+    int firstProperty;
+    int propertyCount;
+
+    static Factory factoryOf(QByteArrayView className);
+};
+
+class QLoaderStaticTree
+{
+public:
+    QByteArrayView fileName;
+    QByteArrayView shebang;
+    const QLoaderStaticSection *sections;
+    int sectionCount;
+    const QLoaderStaticProperty *properties;
+};
+
+#endif // QLOADERSTATICTREE_H
@@ -0,0 +1,51 @@
+// Copyright (C) 2026 Sergey Naumov <sergey@naumov.io>
+// SPDX-License-Identifier: 0BSD
+
+#include "qloadertransaction.h"
+#include "qloadertree.h"
+#include "qloadertree_p.h"
+
+QLoaderTransaction::QLoaderTransaction(QLoaderTree *tree)
+:   d_ptr(new QLoaderTransactionPrivate{tree})
+{ }
+
+QLoaderTransaction::~QLoaderTransaction()
+{ }
+
+QLoaderError QLoaderTransaction::commit()
+{
+    QLoaderError error = d_ptr->tree->d_ptr->commit(d_ptr->operations);
+    d_ptr->operations.clear();
+
+    return error;
+}
+
+void QLoaderTransaction::copy(QStringView section, QStringView to)
+{
+    d_ptr->operations.append({QLoaderTransactionPrivate::Copy, section.toString(), to.toString(), {}, {}});
+}
+
+bool QLoaderTransaction::isEmpty() const
+{
+    return d_ptr->operations.isEmpty();
+}
+
+void QLoaderTransaction::move(QStringView section, QStringView to)
+{
+    d_ptr->operations.append({QLoaderTransactionPrivate::Move, section.toString(), to.toString(), {}, {}});
+}
+
+void QLoaderTransaction::remove(QStringView section, QStringView key)
+{
+    setValue(section, key, QVariant());
+}
+
+void QLoaderTransaction::rollback()
+{
+    d_ptr->operations.clear();
+}
+
+void QLoaderTransaction::setValue(QStringView section, QStringView key, const QVariant &value)
+{
+    d_ptr->operations.append({QLoaderTransactionPrivate::SetValue, section.toString(), key.toString(), value, {}});
+}
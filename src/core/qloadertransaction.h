@@ -0,0 +1,33 @@
+// Copyright (C) 2026 Sergey Naumov <sergey@naumov.io>
+// SPDX-License-Identifier: 0BSD
+
+#ifndef QLOADERTRANSACTION_H
+#define QLOADERTRANSACTION_H
+
+#include "qtloaderglobal.h"
+#include "qloadererror.h"
+#include <QVariant>
+
+class QLoaderTransactionPrivate;
+class QLoaderTree;
+
+class Q_LOADER_EXPORT QLoaderTransaction
+{
+    Q_DISABLE_COPY(QLoaderTransaction)
+
+    const QScopedPointer<QLoaderTransactionPrivate> d_ptr;
+
+public:
+    explicit QLoaderTransaction(QLoaderTree *tree);
+    ~QLoaderTransaction();
+
+    QLoaderError commit();
+    void copy(QStringView section, QStringView to);
+    bool isEmpty() const;
+    void move(QStringView section, QStringView to);
+    void remove(QStringView section, QStringView key);
+    void rollback();
+    void setValue(QStringView section, QStringView key, const QVariant &value);
+};
+
+#endif // QLOADERTRANSACTION_H
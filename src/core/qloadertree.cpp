@@ -17,6 +17,11 @@ QLoaderTree::QLoaderTree(const QString &fileName, QObject *parent)
     d_ptr(new QLoaderTreePrivate(fileName, this))
 { }
 
+QLoaderTree::QLoaderTree(const QLoaderStaticTree &tree, QObject *parent)
+:   QObject(parent),
+    d_ptr(new QLoaderTreePrivate(tree, this))
+{ }
+
 QLoaderTree::~QLoaderTree()
 { }
 
@@ -25,20 +30,60 @@ QLoaderError QLoaderTree::backup()
     return {};
 }
 
+QLoaderError QLoaderTree::check(CheckOptions options) const
+{
+    return d_ptr->check(options);
+}
+
 bool QLoaderTree::contains(QStringView section) const
 {
+    if (QLoaderSnapshotReader snapshot(*d_ptr); snapshot)
+    {
+        return QLoaderAtomTable::withUtf8(section, [&snapshot](QByteArrayView utf8)
+        {
+            return snapshot->find(utf8) != -1;
+        });
+    }
+
     d_ptr->mutex.lock();
-    bool containsSection = d_ptr->hash.settings.sections.contains(section);
+    bool containsSection = d_ptr->find(section);
     d_ptr->mutex.unlock();
 
     return containsSection;
 }
 
+bool QLoaderTree::contains(QLoaderSectionHandle handle) const
+{
+    QMutexLocker locker(&d_ptr->mutex);
+    return d_ptr->find(handle);
+}
+
 QLoaderError QLoaderTree::copy(QStringView section, QStringView to)
 {
     return d_ptr->copy(section, to);
 }
 
+qint64 QLoaderTree::evict()
+{
+    if (!d_ptr->loadOptions.testFlag(LowMemory))
+        return 0;
+
+    QMutexLocker locker(&d_ptr->mutex);
+    return d_ptr->evict(false);
+}
+
+qint64 QLoaderTree::evictedSize() const
+{
+    QMutexLocker locker(&d_ptr->mutex);
+    return d_ptr->evicted;
+}
+
+QLoaderError QLoaderTree::exportTree(QIODevice *device, ExportFormat format) const
+{
+    QMutexLocker locker(&d_ptr->mutex);
+    return d_ptr->exportTree(device, format);
+}
+
 QString QLoaderTree::fileName() const
 {
     if (d_ptr->file)
@@ -47,6 +92,15 @@ QString QLoaderTree::fileName() const
     return {};
 }
 
+QLoaderSectionHandle QLoaderTree::handle(QStringView section) const
+{
+    QMutexLocker locker(&d_ptr->mutex);
+    if (QLoaderSettings *settings = d_ptr->find(section))
+        return d_ptr->handle(settings);
+
+    return {};
+}
+
 bool QLoaderTree::isLoaded() const
 {
     return d_ptr->loaded;
@@ -62,6 +116,11 @@ QLoaderError QLoaderTree::load() const
     return d_ptr->load();
 }
 
+QLoaderTree::LoadOptions QLoaderTree::loadOptions() const
+{
+    return d_ptr->loadOptions;
+}
+
 QLoaderError QLoaderTree::move(QStringView section, QStringView to)
 {
     return d_ptr->move(section, to);
@@ -74,15 +133,45 @@ QLoaderShell *QLoaderTree::newShellInstance() const
 
 QObject *QLoaderTree::object(QStringView section) const
 {
+    if (QLoaderSnapshotReader snapshot(*d_ptr); snapshot)
+    {
+        return QLoaderAtomTable::withUtf8(section, [&snapshot](QByteArrayView utf8) -> QObject *
+        {
+            const QLoaderSnapshot::Node *item = snapshot->node(snapshot->find(utf8));
+            return (item ? item->object : nullptr);
+        });
+    }
+
     QObject *object{};
     d_ptr->mutex.lock();
-    if (d_ptr->hash.settings.sections.contains(section))
-        object = d_ptr->hash.data.value(d_ptr->hash.settings.sections.value(section)).object;
+    if (QLoaderSettings *settings = d_ptr->find(section))
+        object = d_ptr->node(settings).object;
     d_ptr->mutex.unlock();
 
     return object;
 }
 
+QObject *QLoaderTree::object(QLoaderSectionHandle handle) const
+{
+    QMutexLocker locker(&d_ptr->mutex);
+    if (QLoaderSettings *settings = d_ptr->find(handle))
+        return d_ptr->node(settings).object;
+
+    return nullptr;
+}
+
+QString QLoaderTree::resolve(QStringView section, QStringView relative) const
+{
+    QMutexLocker locker(&d_ptr->mutex);
+    if (QLoaderSettings *settings = d_ptr->find(section))
+    {
+        if ((settings = d_ptr->resolve(settings, relative)))
+            return d_ptr->section(settings);
+    }
+
+    return {};
+}
+
 QLoaderError QLoaderTree::save() const
 {
     QLoaderError error;
@@ -101,13 +190,65 @@ QLoaderError QLoaderTree::save() const
     return error;
 }
 
+QString QLoaderTree::section(QLoaderSectionHandle handle) const
+{
+    QMutexLocker locker(&d_ptr->mutex);
+    if (QLoaderSettings *settings = d_ptr->find(handle))
+        return d_ptr->section(settings);
+
+    return {};
+}
+
+void QLoaderTree::setLoadOptions(LoadOptions options)
+{
+    d_ptr->loadOptions = options;
+}
+
+QStringList QLoaderTree::sections(QStringView section) const
+{
+    QStringList sections;
+
+    QMutexLocker locker(&d_ptr->mutex);
+    if (QLoaderSettings *settings = d_ptr->find(section))
+        d_ptr->sectionsRecursive(settings, d_ptr->section(settings), sections);
+
+    return sections;
+}
+
 QLoaderSettings *QLoaderTree::settings(QObject *object) const
 {
+    const QLoaderSettings *instance = dynamic_cast<const QLoaderSettings *>(object);
+    if (QLoaderSnapshotReader snapshot(*d_ptr); snapshot && instance)
+        return d_ptr->instance(*snapshot, instance, object);
+
     QLoaderSettings *settings{};
     d_ptr->mutex.lock();
-    if (d_ptr->hash.settings.objects.contains(object))
-        settings = d_ptr->hash.settings.objects.value(object);
+    settings = d_ptr->nodes.objects.value(object);
     d_ptr->mutex.unlock();
 
     return settings;
 }
+
+QLoaderSettings *QLoaderTree::settings(QLoaderSectionHandle handle) const
+{
+    QMutexLocker locker(&d_ptr->mutex);
+    if (QLoaderSettings *settings = d_ptr->find(handle))
+    {
+        const QList<QLoaderSettings *> &instances = d_ptr->node(settings).settings;
+        return (instances.size() ? instances.front() : nullptr);
+    }
+
+    return nullptr;
+}
+
+int QLoaderTree::subscribe(QStringView section, QObject *context, std::function<void(const QLoaderChange &)> function)
+{
+    QMutexLocker locker(&d_ptr->mutex);
+    return d_ptr->subscribe(section, context, std::move(function));
+}
+
+void QLoaderTree::unsubscribe(int subscription)
+{
+    QMutexLocker locker(&d_ptr->mutex);
+    d_ptr->unsubscribe(subscription);
+}
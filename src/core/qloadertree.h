@@ -5,18 +5,24 @@
 #define QLOADERTREE_H
 
 #include "qtloaderglobal.h"
+#include "qloaderchange.h"
 #include "qloadererror.h"
 #include <QObject>
+#include <functional>
 
+class QIODevice;
 class QLoaderTreePrivate;
 class QLoaderSettings;
 class QLoaderShell;
+class QLoaderStaticTree;
 
 class Q_LOADER_EXPORT QLoaderTree : public QObject
 {
     Q_OBJECT
     Q_DISABLE_COPY(QLoaderTree)
 
+    friend class QLoaderTransaction;
+
 protected:
     const QScopedPointer<QLoaderTreePrivate> d_ptr;
 
@@ -30,21 +36,67 @@ Q_SIGNALS:
     void warningChanged(QObject *sender, QString message);
 
 public:
+    enum LoadOption
+    {
+        NoLoadOptions = 0x0,
+        UseCompiledCache = 0x1,
+        ParallelParse = 0x2,
+        LowMemory = 0x4,
+    };
+    Q_DECLARE_FLAGS(LoadOptions, LoadOption)
+    Q_ENUM(LoadOption)
+    Q_FLAG(LoadOptions)
+
+    enum CheckOption
+    {
+        NoCheckOptions = 0x0,
+        ResolvePlugins = 0x1,
+    };
+    Q_DECLARE_FLAGS(CheckOptions, CheckOption)
+    Q_ENUM(CheckOption)
+    Q_FLAG(CheckOptions)
+
+    enum ExportFormat
+    {
+        CborFormat,
+        JsonFormat
+    };
+    Q_ENUM(ExportFormat)
+
     explicit QLoaderTree(const QString &fileName, QObject *parent = nullptr);
+    explicit QLoaderTree(const QLoaderStaticTree &tree, QObject *parent = nullptr);
     ~QLoaderTree();
 
     QLoaderError backup();
+    QLoaderError check(CheckOptions options = NoCheckOptions) const;
     bool contains(QStringView section) const;
+    bool contains(QLoaderSectionHandle handle) const;
     QLoaderError copy(QStringView section, QStringView to);
+    qint64 evict();
+    qint64 evictedSize() const;
+    QLoaderError exportTree(QIODevice *device, ExportFormat format = CborFormat) const;
     QString fileName() const;
+    QLoaderSectionHandle handle(QStringView section) const;
     bool isLoaded() const;
     bool isModified() const;
     QLoaderError load() const;
+    LoadOptions loadOptions() const;
     QLoaderError move(QStringView section, QStringView to);
     QLoaderShell *newShellInstance() const;
     QObject *object(QStringView section) const;
+    QObject *object(QLoaderSectionHandle handle) const;
+    QString resolve(QStringView section, QStringView relative) const;
     QLoaderError save() const;
+    QString section(QLoaderSectionHandle handle) const;
+    QStringList sections(QStringView section) const;
+    void setLoadOptions(LoadOptions options);
     QLoaderSettings *settings(QObject *object) const;
+    QLoaderSettings *settings(QLoaderSectionHandle handle) const;
+    int subscribe(QStringView section, QObject *context, std::function<void(const QLoaderChange &)> function);
+    void unsubscribe(int subscription);
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(QLoaderTree::CheckOptions)
+Q_DECLARE_OPERATORS_FOR_FLAGS(QLoaderTree::LoadOptions)
+
 #endif // QLOADERTREE_H
@@ -3,6 +3,7 @@
 
 #include "qloadertree_p.h"
 #include "qloadermarkupeditor.h"
+#include "qloaderparser.h"
 #include "qloadertree.h"
 #include "qloaderplugininterface.h"
 #include "qloadersaveinterface.h"
@@ -12,16 +13,30 @@
 #include "qloadershellexit.h"
 #include "qloadershellsave.h"
 #include "qloaderterminal.h"
+#include "qloadervariantconverter_p.h"
 #include <QAction>
 #include <QApplication>
+#include <QCborStreamReader>
+#include <QCborStreamWriter>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QLabel>
+#include <QLibrary>
 #include <QMainWindow>
 #include <QMenu>
 #include <QMetaMethod>
 #include <QPluginLoader>
 #include <QRegularExpression>
+#include <QSaveFile>
+#include <QSet>
 #include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+#include <zlib.h>
 
 using namespace Qt::Literals::StringLiterals;
 
@@ -30,6 +45,11 @@ static QStringView objectName(QStringView section)
     return section.sliced(section.lastIndexOf(u'/', -2) + 1);
 }
 
+static QByteArrayView objectName(QByteArrayView section)
+{
+    return section.sliced(section.lastIndexOf('/', -2) + 1);
+}
+
 static QStringView parentSection(QStringView section)
 {
     int splitIndex = section.lastIndexOf(u'/', -2);
@@ -37,6 +57,75 @@ static QStringView parentSection(QStringView section)
     return (splitIndex == -1 ? QStringView{} : section.first(splitIndex));
 }
 
+static QByteArrayView parentSection(QByteArrayView section)
+{
+    qsizetype splitIndex = section.lastIndexOf('/', -2);
+
+    return (splitIndex == -1 ? QByteArrayView{} : section.first(splitIndex));
+}
+
+static bool readCborString(QCborStreamReader &in, QByteArray &string)
+{
+    if (!in.isString())
+        return false;
+
+    string = in.readAllUtf8String();
+
+    return in.lastError() == QCborError::NoError;
+}
+
+static void saveObject(QObject *object)
+{
+    if (QLoaderSaveInterface *resources = qobject_cast<QLoaderSaveInterface *>(object))
+        resources->save();
+}
+
+static bool isReservedKey(QByteArrayView key)
+{
+    return key == "class" || key == "plugin" || key == "include" || key == "template";
+}
+
+static QString compiledFileName(const QString &fileName)
+{
+    if (fileName.endsWith(".qt6"_L1))
+        return fileName + u'c';
+
+    return fileName + u".qt6c"_s;
+}
+
+static bool resolveLibrary(const QString &libraryName)
+{
+    if (QFileInfo(libraryName).isAbsolute())
+        return QLibrary::isLibrary(libraryName) && QFileInfo::exists(libraryName);
+
+    const QStringList paths = QCoreApplication::libraryPaths();
+    for (const QString &path : paths)
+    {
+        const QStringList entries = QDir(path).entryList({libraryName + u".*"_s, u"lib"_s + libraryName + u".*"_s},
+                                                         QDir::Files);
+        for (const QString &entry : entries)
+        {
+            if (QLibrary::isLibrary(entry))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+class CompiledHeader
+{
+public:
+    static constexpr quint32 magic{0x51543643}; // "QT6C"
+    static constexpr quint32 version{5};
+
+    qint64 size{};
+    qint64 modified{};
+    QByteArray digest;
+
+    friend bool operator==(const CompiledHeader &, const CompiledHeader &) = default;
+};
+
 class QLoaderTreeSection
 {
     QLoaderTreeSection(QStringView section)
@@ -69,14 +158,13 @@ public:
             return;
 
         d->mutex.lock();
-        if (!d->hash.settings.sections.contains(parent.section))
+        if (!(parent.settings = d->find(parent.section)))
             valid = false;
         else
         {
             valid = true;
-            parent.settings = d->hash.settings.sections.value(parent.section);
-            settings = d->hash.settings.sections.value(section);
-            object = d->hash.data.value(settings).object;
+            settings = d->child(parent.settings, d->atoms.find(objectName(section)));
+            object = (settings ? d->node(settings).object : nullptr);
         }
         d->mutex.unlock();
     }
@@ -112,7 +200,7 @@ public:
         if (!loaded)
             return {.status = QLoaderError::Object, .message = u"tree not loaded"_s};
 
-        if (!src.valid || !dst.valid)
+        if (!src.valid || !src.settings || !dst.valid)
             return {.status = QLoaderError::Design, .message = u"section not valid"_s};
 
         if (QLoaderError err = actionError())
@@ -123,26 +211,12 @@ public:
 
         return {};
     }
-
-    static QString section(const QStringList &itemSection,
-                           const QStringList &srcSection,
-                           const QStringList &dstSection)
-    {
-        int size = itemSection.size() + (dstSection.size() - srcSection.size());
-        QStringList retSection(size);
-        std::copy_n(dstSection.begin(), dstSection.size(), retSection.begin());
-        std::copy_n(itemSection.begin() + srcSection.size(),
-                    itemSection.size() - srcSection.size(),
-                    retSection.begin() + dstSection.size());
-
-        return retSection.join(u'/');
-    }
 };
 
 template<>
 QLoaderError QLoaderTreeSectionAction<Copy>::actionError() const
 {
-    if (!d_ptr->hash.data[src.settings].settings.front()->isCopyable(dst.section))
+    if (!d_ptr->node(src.settings).settings.front()->isCopyable(dst.section))
         return {.status = QLoaderError::Object, .message = actionPath() + u" : copy operation not allowed"_s};
 
     return {};
@@ -151,123 +225,479 @@ QLoaderError QLoaderTreeSectionAction<Copy>::actionError() const
 template<>
 QLoaderError QLoaderTreeSectionAction<Move>::actionError() const
 {
-    if (!d_ptr->hash.data[src.settings].settings.front()->isMovable(dst.section))
+    if (!d_ptr->node(src.settings).settings.front()->isMovable(dst.section))
         return {.status = QLoaderError::Object, .message = actionPath() + u" : move operation not allowed"_s};
 
     return {};
 }
 
+class SettingsLine
+{
+public:
+    enum Type
+    {
+        Section,
+        KeyValue,
+        Invalid
+    };
+
+    int line{};
+    Type type{};
+    QByteArrayView key;
+    QByteArrayView value;
+    qint64 offset{-1};
+};
+
+class SettingsParser : public QLoaderParser
+{
+protected:
+    bool error(QByteArrayView) override
+    {
+        return read(SettingsLine{.line = lineNumber(), .type = SettingsLine::Invalid});
+    }
+
+    bool keyValue(QByteArrayView key, QByteArrayView value) override
+    {
+        return read(SettingsLine{.line = lineNumber(), .type = SettingsLine::KeyValue, .key = key, .value = value});
+    }
+
+    bool section(QByteArrayView section) override
+    {
+        return read(SettingsLine{.line = lineNumber(),
+                                 .type = SettingsLine::Section,
+                                 .key = section,
+                                 .offset = lineOffset()});
+    }
+
+    bool shebang(QByteArrayView line) override
+    {
+        shebangLine = QString::fromUtf8(line);
+        return true;
+    }
+
+public:
+    std::function<bool(SettingsLine &&)> read;
+    QString shebangLine;
+};
+
 class KeyValueParser
 {
     const QRegularExpression className{u"^[A-Z]+[a-z,0-9]*"_s};
 
 public:
-    bool matchSectionName(const QString &line, QString &section) const
+    bool matchClassName(const char *name, QString &libraryName) const
     {
-        if (line.size() > 2 &&
-            line.front() == u'[' &&
-            line.back() == u']' &&
-            line.indexOf(u'[', 1) == -1 &&
-            line.lastIndexOf(u']', -2) == -1)
+        QRegularExpressionMatch match;
+        if ((match = className.match(QString::fromLocal8Bit(name))).hasMatch())
         {
-            section = line.sliced(1, line.size() - 2);
+            libraryName += match.capturedView();
             return true;
         }
 
         return false;
     }
+};
 
-    bool matchKeyValue(const QString &line, QString &key, QString &value) const
+class SettingsChunk
+{
+    static constexpr qsizetype minimumSize{64 * 1024};
+
+public:
+    class Entry
     {
-        int splitIndex = line.indexOf(u'=');
+    public:
+        SettingsLine line;
+        int key{-1};
+        QByteArray value;
+    };
 
-        if (splitIndex > 0)
-        {
-            QStringView view(line);
+    QByteArrayView data;
+    int lineCount{};
+    QList<QByteArrayView> keys;
+    QList<Entry> entries;
+    QString shebang;
+
+    static QList<SettingsChunk> split(QByteArrayView data)
+    {
+        const qsizetype count = qBound(qsizetype(1),
+                                       data.size() / minimumSize,
+                                       qsizetype(QThread::idealThreadCount()));
+        QList<SettingsChunk> chunks;
+        qsizetype chunkStart{};
 
-            if ((view = view.first(splitIndex).trimmed()).size())
+        for (qsizetype i = 1; chunkStart < data.size(); ++i)
+        {
+            qsizetype chunkEnd = data.size();
+            if (i < count)
             {
-                key = view.toString();
-                value = QStringView(line).sliced(splitIndex + 1).trimmed().toString();
-                return true;
+                qsizetype splitIndex = data.indexOf("\n[", std::max(chunkStart, data.size() / count * i));
+                if (splitIndex != -1)
+                    chunkEnd = splitIndex + 1;
             }
+
+            chunks.append(SettingsChunk{.data = data.sliced(chunkStart, chunkEnd - chunkStart)});
+            chunkStart = chunkEnd;
         }
 
-        return false;
+        return chunks;
     }
 
-    bool matchClassName(const char *name, QString &libraryName) const
+    void read()
     {
-        QRegularExpressionMatch match;
-        if ((match = className.match(QString::fromLocal8Bit(name))).hasMatch())
+        QHash<QByteArrayView, int> keyIndex;
+
+        SettingsParser parser;
+        parser.read = [this, &keyIndex](SettingsLine &&line)
         {
-            libraryName += match.capturedView();
+            if (line.type != SettingsLine::KeyValue || isReservedKey(line.key))
+            {
+                entries.append({.line = std::move(line)});
+                return entries.back().line.type != SettingsLine::Invalid;
+            }
+
+            auto i = keyIndex.constFind(line.key);
+            if (i == keyIndex.cend())
+            {
+                i = keyIndex.insert(line.key, int(keys.size()));
+                keys.append(line.key);
+            }
+
+            QByteArray value = line.value.toByteArray();
+            entries.append({.line = line, .key = *i, .value = std::move(value)});
             return true;
+        };
+
+        parser.parse(data);
+        lineCount = parser.lineNumber();
+        shebang = std::move(parser.shebangLine);
+    }
+};
+
+class SettingsInclude
+{
+public:
+    qint64 modified{};
+    QByteArray data;
+    QList<SettingsLine> lines;
+
+    static std::shared_ptr<const SettingsInclude> open(const QString &fileName)
+    {
+        static constexpr qsizetype cacheSize{16};
+        static QMutex mutex;
+        static QHash<QString, std::pair<std::shared_ptr<const SettingsInclude>, quint64>> cache;
+        static quint64 used{};
+
+        const qint64 modified = QFileInfo(fileName).lastModified().toMSecsSinceEpoch();
+
+        QMutexLocker locker(&mutex);
+        if (!cache.contains(fileName) && cache.size() >= cacheSize)
+        {
+            auto oldest = cache.begin();
+            for (auto i = cache.begin(); i != cache.end(); ++i)
+            {
+                if (i->second < oldest->second)
+                    oldest = i;
+            }
+            cache.erase(oldest);
         }
 
-        return false;
+        auto &[include, lastUsed] = cache[fileName];
+        lastUsed = ++used;
+        if (include && include->modified == modified)
+            return include;
+
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            cache.remove(fileName);
+            return {};
+        }
+
+        std::shared_ptr<SettingsInclude> parsed = std::make_shared<SettingsInclude>();
+        parsed->modified = modified;
+        parsed->data = file.readAll();
+
+        SettingsParser parser;
+        parser.read = [&lines = parsed->lines](SettingsLine &&line)
+        {
+            lines.append(std::move(line));
+            return lines.back().type != SettingsLine::Invalid;
+        };
+        parser.parse(parsed->data);
+
+        return include = std::move(parsed);
     }
 };
 
-class StringVariantConverter
+class SettingsTemplate
+{
+public:
+    QLoaderSettings *settings{};
+    QByteArray section;
+    int line{};
+};
+
+class SettingsReader
+{
+public:
+    QLoaderSettings *settings{};
+    QLoaderSettingsData item;
+    QLoaderError error;
+    QStringList includes;
+    QList<SettingsTemplate> templates;
+    bool included{};
+
+    bool hasTemplate() const { return templates.size() && templates.constLast().settings == settings; }
+};
+
+class SettingsExport
 {
-    const QRegularExpression bytearray{u"^QByteArray\\s*\\(\\s*(.*)\\)"_s};
+    QIODevice *const device;
+    QCborStreamWriter cbor;
+    const bool json;
+    bool first{true};
+    bool failed{};
+
+    void write(QByteArrayView data)
+    {
+        if (device->write(data.data(), data.size()) != data.size())
+            failed = true;
+    }
+
+    void writeString(QByteArrayView string)
+    {
+        if (!json)
+        {
+            cbor.appendTextString(string.data(), string.size());
+            return;
+        }
+
+        QByteArray escaped;
+        escaped.reserve(string.size() + 2);
+        escaped += '"';
+        for (char c : string)
+        {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+
+            if (uchar(c) < 0x20)
+                escaped += "\\u00" + QByteArray::number(uchar(c), 16).rightJustified(2, '0');
+            else
+                escaped += c;
+        }
+        escaped += '"';
+
+        write(escaped);
+    }
 
-    const QRegularExpression color_rgb{u"^QColor\\s*\\(\\s*(?<r>\\d+)\\s*\\,"
-                                       u"\\s*(?<g>\\d+)\\s*\\,"
-                                       u"\\s*(?<b>\\d+)\\s*\\)"_s};
+    void writeKeyValue(QByteArrayView key, QByteArrayView value, bool &comma)
+    {
+        if (json && std::exchange(comma, true))
+            write(",");
 
-    const QRegularExpression color_rgba{u"^QColor\\s*\\(\\s*(?<r>\\d+)\\s*\\,"
-                                        u"\\s*(?<g>\\d+)\\s*\\,"
-                                        u"\\s*(?<b>\\d+)\\s*\\,"
-                                        u"\\s*(?<a>\\d+)\\s*\\)"_s};
+        writeString(key);
+        if (json)
+            write(":");
 
-    const QRegularExpression size{u"^QSize\\s*\\(\\s*(?<width>\\d+)\\s*\\,\\s*(?<height>\\d+)\\s*\\)"_s};
+        writeString(value);
+    }
 
 public:
-    QVariant fromString(const QString &value) const
+    SettingsExport(QIODevice *out, bool isJson)
+    :   device(out),
+        cbor(out),
+        json(isJson)
+    { }
+
+    bool hasError() const
     {
-        if (value.at(0) != u'Q')
-            return value;
+        QFileDevice *fileDevice = qobject_cast<QFileDevice *>(device);
+        return failed || (fileDevice && fileDevice->error() != QFileDevice::NoError);
+    }
 
-        QStringView view(QStringView(value).sliced(1));
-        QRegularExpressionMatch match;
+    void begin(const QString &shebang)
+    {
+        bool comma{};
+        if (json)
+            write("{");
+        else
+        {
+            cbor.append(QCborKnownTags::Signature);
+            cbor.startMap();
+        }
+
+        if (shebang.size())
+            writeKeyValue("shebang", shebang.toUtf8(), comma);
+
+        if (json)
+            write(comma ? ",\"sections\":[" : "\"sections\":[");
+        else
+        {
+            writeString("sections");
+            cbor.startArray();
+        }
+    }
 
-        if (view.startsWith("ByteArray"_L1) && (match = bytearray.match(value)).hasMatch())
-            return QVariant::fromValue(QByteArray::fromBase64(match.capturedView(1).toLocal8Bit()));
+    void end()
+    {
+        if (json)
+            write("]}\n");
+        else
+        {
+            cbor.endArray();
+            cbor.endMap();
+        }
+    }
+
+    void section(const QLoaderSettingsData &item, const QString &section, const QString &base)
+    {
+        bool comma{};
+        if (json)
+            write(std::exchange(first, false) ? "{" : ",{");
+        else
+            cbor.startMap();
 
-        if (view.startsWith("Color"_L1))
+        writeKeyValue("section", section.toUtf8(), comma);
+        writeKeyValue("class", item.className, comma);
+
+        if (item.pluginName.size())
+            writeKeyValue("plugin", item.pluginName.toUtf8(), comma);
+
+        if (item.include.size())
+            writeKeyValue("include", item.include.toUtf8(), comma);
+
+        if (base.size())
+            writeKeyValue("template", base.toUtf8(), comma);
+
+        if (json)
+            write(",\"properties\":{");
+        else
         {
-            if ((match = color_rgb.match(value)).hasMatch())
-                return QColor(match.capturedView(u"r"_s).toInt(),
-                              match.capturedView(u"g"_s).toInt(),
-                              match.capturedView(u"b"_s).toInt());
+            writeString("properties");
+            cbor.startMap();
+        }
 
-            if ((match = color_rgba.match(value)).hasMatch())
-                return QColor(match.capturedView(u"r"_s).toInt(),
-                              match.capturedView(u"g"_s).toInt(),
-                              match.capturedView(u"b"_s).toInt(),
-                              match.capturedView(u"a"_s).toInt());
+        comma = false;
+        for (auto i = item.properties.cbegin(), end = item.properties.cend(); i != end; ++i)
+            writeKeyValue(i.key().view(), i.value(), comma);
+
+        if (json)
+            write("}}");
+        else
+        {
+            cbor.endMap();
+            cbor.endMap();
         }
+    }
+};
+
+class GzipDevice : public QIODevice
+{
+    QByteArrayView input;
+    QIODevice *const output{};
+    z_stream stream{};
+
+    bool deflateTo(int flush)
+    {
+        char buffer[16 * 1024];
+        do
+        {
+            stream.next_out = reinterpret_cast<Bytef *>(buffer);
+            stream.avail_out = sizeof(buffer);
+            status = deflate(&stream, flush);
+
+            const qint64 size = qint64(sizeof(buffer) - stream.avail_out);
+            if (status == Z_STREAM_ERROR || output->write(buffer, size) != size)
+                return false;
+
+        } while (!stream.avail_out);
+
+        return true;
+    }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override
+    {
+        const uInt size = uInt(qMin(maxSize, qint64(1) << 30));
+        stream.next_out = reinterpret_cast<Bytef *>(data);
+        stream.avail_out = size;
+
+        while (stream.avail_out && status == Z_OK)
+            status = inflate(&stream, Z_NO_FLUSH);
+
+        return qint64(size - stream.avail_out);
+    }
+
+    qint64 writeData(const char *data, qint64 maxSize) override
+    {
+        stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+        stream.avail_in = uInt(maxSize);
+
+        if (deflateTo(Z_NO_FLUSH))
+            return maxSize;
+
+        failed = true;
+        return -1;
+    }
+
+public:
+    int status{Z_OK};
+    bool failed{};
 
-        if (view.startsWith("Size"_L1) && (match = size.match(value)).hasMatch())
-            return QSize(match.capturedView(u"width"_s).toInt(), match.capturedView(u"height"_s).toInt());
+    GzipDevice(QByteArrayView source)
+    :   input(source)
+    { }
+
+    GzipDevice(QIODevice *sink)
+    :   output(sink)
+    { }
+
+    ~GzipDevice()
+    {
+        close();
+    }
 
-        return value;
+    bool atEnd() const override
+    {
+        return status != Z_OK && QIODevice::atEnd();
     }
 
-    QString fromVariant(const QVariant &variant) const
+    void close() override
     {
-        QMetaType::Type type = static_cast<QMetaType::Type>(variant.metaType().id());
+        if (!isOpen())
+            return;
 
-        if (type == QMetaType::QByteArray)
-            return QString(u"QByteArray("_s + QLatin1StringView(variant.toByteArray().toBase64()) + u')');
+        if (output)
+        {
+            if (!deflateTo(Z_FINISH) || status != Z_STREAM_END)
+                failed = true;
+
+            if (deflateEnd(&stream) != Z_OK)
+                failed = true;
+        }
+        else
+            inflateEnd(&stream);
+
+        QIODevice::close();
+    }
+
+    bool isSequential() const override
+    {
+        return true;
+    }
 
-        if (type == QMetaType::QSize)
-            return QString(u"QSize("_s + QString::number(variant.toSize().width()) + u", "_s
-                                       + QString::number(variant.toSize().height()) + u')');
+    bool open(OpenMode mode) override
+    {
+        if (output)
+            status = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+        else
+        {
+            stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(input.data()));
+            stream.avail_in = uInt(input.size());
+            status = inflateInit2(&stream, 16 + MAX_WBITS);
+        }
 
-        return variant.toString();
+        return status == Z_OK && QIODevice::open(mode);
     }
 };
 
@@ -325,7 +755,7 @@ public:
     SettingsObject shell;
 
     KeyValueParser parser;
-    StringVariantConverter converter;
+    QLoaderVariantConverter converter;
     QMutex loading;
     QString shebang;
     QList<QLoaderSettings *> copied;
@@ -346,17 +776,30 @@ QLoaderTreePrivate::QLoaderTreePrivate(const QString &fileName, QLoaderTree *q)
     static_assert(alignof(QLoaderTreePrivateData) == 8);
 }
 
+QLoaderTreePrivate::QLoaderTreePrivate(const QLoaderStaticTree &tree, QLoaderTree *q)
+:   QLoaderTreePrivate(QString::fromUtf8(tree.fileName), q)
+{
+    staticTree = &tree;
+}
+
 QLoaderTreePrivate::~QLoaderTreePrivate()
 {
+    loaded = false;
     d.~QLoaderTreePrivateData();
-    qDeleteAll(hash.settings.sections);
+    for (QLoaderSettings *settings : std::as_const(nodes.settings))
+    {
+        if (settings)
+            settings->~QLoaderSettings();
+    }
+
+    delete published.exchange(nullptr);
 }
 
-QObject *QLoaderTreePrivate::builtin(QLoaderSettings *settings, QObject *parent)
+QObject *QLoaderTreePrivate::builtin(QLoaderStaticSection::Factory factory,
+                                     QLoaderSettings *settings,
+                                     QObject *parent)
 {
-    const char *shortName = settings->className() + std::char_traits<char>::length("QLoader");
-
-    if (!strcmp(shortName, "ShellCd"))
+    if (factory == QLoaderStaticSection::ShellCd)
     {
         if (QLoaderShell *shell = qobject_cast<QLoaderShell *>(parent))
             return new QLoaderShellCd(settings, shell);
@@ -364,7 +807,7 @@ QObject *QLoaderTreePrivate::builtin(QLoaderSettings *settings, QObject *parent)
         return parent;
      }
 
-    if (!strcmp(shortName, "ShellExit"))
+    if (factory == QLoaderStaticSection::ShellExit)
     {
         if (QLoaderShell *shell = qobject_cast<QLoaderShell *>(parent))
             return new QLoaderShellExit(settings, shell);
@@ -372,7 +815,7 @@ QObject *QLoaderTreePrivate::builtin(QLoaderSettings *settings, QObject *parent)
         return parent;
      }
 
-    if (!strcmp(shortName, "ShellSave"))
+    if (factory == QLoaderStaticSection::ShellSave)
     {
         if (QLoaderShell *shell = qobject_cast<QLoaderShell *>(parent))
             return new QLoaderShellSave(settings, shell);
@@ -380,7 +823,7 @@ QObject *QLoaderTreePrivate::builtin(QLoaderSettings *settings, QObject *parent)
         return parent;
      }
 
-    if (!strcmp(shortName, "Shell"))
+    if (factory == QLoaderStaticSection::Shell)
     {
         if (!d.shell.object)
             return d.shell.object = new QLoaderShell(settings);
@@ -391,7 +834,7 @@ QObject *QLoaderTreePrivate::builtin(QLoaderSettings *settings, QObject *parent)
     bool coreApp = !qobject_cast<QApplication *>(QCoreApplication::instance());
     QWidget *widget = qobject_cast<QWidget *>(parent);
 
-    if (!strcmp(shortName, "Terminal"))
+    if (factory == QLoaderStaticSection::Terminal)
     {
         if (coreApp)
             return nullptr;
@@ -402,7 +845,7 @@ QObject *QLoaderTreePrivate::builtin(QLoaderSettings *settings, QObject *parent)
         return parent;
     }
 
-    if (!strcmp(shortName, "MarkupEditor"))
+    if (factory == QLoaderStaticSection::MarkupEditor)
     {
         if (coreApp)
             return nullptr;
@@ -416,31 +859,182 @@ QObject *QLoaderTreePrivate::builtin(QLoaderSettings *settings, QObject *parent)
     return q_ptr;
 }
 
-QObject *QLoaderTreePrivate::external(QLoaderError &error,
-                                      QLoaderSettings *settings,
-                                      QObject *parent)
+void QLoaderTreePrivate::changed(QLoaderChange::Kind kind, QLoaderSettings *settings, const QString &key,
+                                 const QString &from, QLoaderSettings *parent)
 {
-    QString libraryName = d.libraryPrefix;
+    if (changes.subscriptions.isEmpty())
+        return;
 
-    mutex.lock();
-    QString pluginName = hash.data[settings].pluginName;
-    mutex.unlock();
+    QList<int> subscriptions;
+    auto match = [this, &subscriptions](QLoaderSettings *ancestor)
+    {
+        for (;; ancestor = node(ancestor).parent)
+        {
+            for (auto i = changes.sections.constFind(ancestor); i != changes.sections.cend() && i.key() == ancestor; ++i)
+            {
+                if (!subscriptions.contains(i.value()))
+                    subscriptions.append(i.value());
+            }
 
-    if (pluginName.size())
-        libraryName += pluginName;
+            if (!ancestor)
+                break;
+        }
+    };
+
+    match(settings);
+    if (parent)
+        match(parent);
 
-    if (pluginName.size() || d.parser.matchClassName(settings->className(), libraryName))
+    if (subscriptions.isEmpty())
+        return;
+
+    QLoaderChange change{.kind = kind,
+                         .section = section(settings),
+                         .key = key,
+                         .from = from,
+                         .handle = handle(settings)};
+    for (int id : std::as_const(subscriptions))
     {
-        QLoaderPluginInterface *plugin = d.plugins.value(libraryName);
+        const QLoaderSubscription &subscription = changes.subscriptions[id];
+        changes.pending.append({subscription.context, subscription.function, change});
+    }
+}
 
-        if (plugin)
-            return plugin->object(settings, parent);
+QLoaderSettings *QLoaderTreePrivate::child(QLoaderSettings *parent, QLoaderAtom name) const
+{
+    if (name.isNull())
+        return nullptr;
 
-        QPluginLoader *loader = new QPluginLoader(libraryName, q_ptr);
-        if (!loader->instance())
-        {
+    if (!parent)
+        return (d.root.settings && node(d.root.settings).name == name ? d.root.settings : nullptr);
+
+    return nodes.children.value({parent, name});
+}
+
+QLoaderError QLoaderTreePrivate::check(QLoaderTree::CheckOptions options)
+{
+    QLoaderError error;
+    d.loading.lock();
+
+    if (!parsed)
+    {
+        checking = true;
+        parsed = readSettings();
+        checking = false;
+        if (*parsed)
+            file->close();
+    }
+
+    if (!(error = *parsed) && d.root.settings)
+        error = checkRecursive(d.root.settings, options);
+
+    d.loading.unlock();
+
+    return error;
+}
+
+QLoaderError QLoaderTreePrivate::checkRecursive(QLoaderSettings *settings, QLoaderTree::CheckOptions options)
+{
+    QLoaderError error;
+
+    mutex.lock();
+    const QLoaderSettingsData &item = node(settings);
+    const QByteArray className = item.className;
+    QLoaderStaticSection::Factory factory = item.factory;
+    const QList<QLoaderSettings *> children = item.children;
+    error.line = item.sectionLine;
+    mutex.unlock();
+
+    if (factory == QLoaderStaticSection::Unresolved)
+        factory = QLoaderStaticSection::factoryOf(className);
+
+    QString libraryName;
+    if (factory == QLoaderStaticSection::NotFound)
+    {
+        error.status = QLoaderError::Object;
+        error.message = u"class \""_s + QLatin1StringView(className) + u"\" not found"_s;
+        return error;
+    }
+    else if (factory == QLoaderStaticSection::External && !pluginLibrary(settings, libraryName))
+    {
+        error.status = QLoaderError::Plugin;
+        error.message = u"class name \""_s + QLatin1StringView(className) + u"\" not valid"_s;
+        return error;
+    }
+    else if (libraryName.size() && options.testFlag(QLoaderTree::ResolvePlugins) && !resolveLibrary(libraryName))
+    {
+        error.status = QLoaderError::Plugin;
+        error.message = u"library \""_s + libraryName + u"\" not found"_s;
+        return error;
+    }
+
+    for (QLoaderSettings *child : children)
+    {
+        if ((error = checkRecursive(child, options)))
+            return error;
+    }
+
+    return {};
+}
+
+void QLoaderTreePrivate::exportRecursive(QLoaderSettings *settings,
+                                         const QString &section,
+                                         SettingsExport &out,
+                                         bool saveObjects)
+{
+    QLoaderSettingsData &item = node(settings);
+    materialize(item);
+    out.section(item, section, item.base ? this->section(item.base) : QString());
+
+    if (saveObjects)
+        saveObject(item.object);
+
+    for (QLoaderSettings *child : item.children)
+    {
+        if (!node(child).included && !node(child).generated)
+            exportRecursive(child, section + u'/' + node(child).name.toString(), out, saveObjects);
+    }
+}
+
+QLoaderError QLoaderTreePrivate::exportTree(QIODevice *device, QLoaderTree::ExportFormat format, bool saveObjects)
+{
+    if (!d.root.settings)
+        return {.status = QLoaderError::Object, .message = u"tree not loaded"_s};
+
+    if (!device->isWritable())
+        return {.status = QLoaderError::Access, .message = u"write error"_s};
+
+    if (evicted && isFileChanged())
+        return {.status = QLoaderError::Access, .message = u"file changed"_s};
+
+    SettingsExport out(device, format == QLoaderTree::JsonFormat);
+    out.begin(d.shebang);
+    exportRecursive(d.root.settings, section(d.root.settings), out, saveObjects);
+    out.end();
+
+    if (out.hasError())
+        return {.status = QLoaderError::Access, .message = u"write error"_s};
+
+    return {};
+}
+
+QObject *QLoaderTreePrivate::external(QLoaderError &error,
+                                      QLoaderSettings *settings,
+                                      QObject *parent)
+{
+    QString libraryName;
+    if (pluginLibrary(settings, libraryName))
+    {
+        QLoaderPluginInterface *plugin = d.plugins.value(libraryName);
+
+        if (plugin)
+            return plugin->object(settings, parent);
+
+        QPluginLoader *loader = new QPluginLoader(libraryName, q_ptr);
+        if (!loader->instance())
+        {
             mutex.lock();
-            error.line = hash.data[settings].sectionLine;
+            error.line = node(settings).sectionLine;
             error.status = QLoaderError::Plugin;
             error.message = u"library \""_s + libraryName + u"\" not loaded"_s;
             mutex.unlock();
@@ -450,7 +1044,7 @@ QObject *QLoaderTreePrivate::external(QLoaderError &error,
         if (!(plugin = qobject_cast<QLoaderPluginInterface *>(loader->instance())))
         {
             mutex.lock();
-            error.line = hash.data[settings].sectionLine;
+            error.line = node(settings).sectionLine;
             error.status = QLoaderError::Plugin;
             error.message = u"interface not valid"_s;
             mutex.unlock();
@@ -463,50 +1057,136 @@ QObject *QLoaderTreePrivate::external(QLoaderError &error,
     }
 
     mutex.lock();
-    error.line = hash.data[settings].sectionLine;
+    error.line = node(settings).sectionLine;
     error.status = QLoaderError::Plugin;
-    error.message = u"class name \""_s + QLatin1StringView(hash.data[settings].className) + u"\" not valid"_s;
+    error.message = u"class name \""_s + QLatin1StringView(node(settings).className) + u"\" not valid"_s;
 
     mutex.unlock();
     return nullptr;
 }
 
+void QLoaderTreePrivate::compileRecursive(QLoaderSettings *settings, const QString &section, QDataStream &out)
+{
+    QLoaderSettingsData &item = node(settings);
+    materialize(item);
+
+    out << section << item.sectionLine << item.className << item.pluginName
+        << (item.base ? this->section(item.base) : QString()) << item.included << item.generated;
+
+    out << quint32(item.properties.size());
+    for (auto i = item.properties.cbegin(), end = item.properties.cend(); i != end; ++i)
+        out << i.key().toUtf8() << i.value();
+
+    for (QLoaderSettings *child : item.children)
+        compileRecursive(child, section + u'/' + node(child).name.toString(), out);
+}
+
+bool QLoaderTreePrivate::endSection(SettingsReader &reader)
+{
+    QLoaderSettings *settings = reader.settings;
+    if (!settings)
+        return true;
+
+    if (reader.item.className.isEmpty() && !reader.hasTemplate())
+    {
+        reader.error.line = reader.item.sectionLine;
+        reader.error.status = QLoaderError::Design;
+        reader.error.message = u"class name not set"_s;
+        return false;
+    }
+
+    node(settings) = std::move(reader.item);
+    reader.item = {};
+    reader.settings = nullptr;
+
+    return node(settings).include.isEmpty() || readInclude(reader, settings);
+}
+
+qint64 QLoaderTreePrivate::evict(bool all)
+{
+    qint64 size{};
+    for (QLoaderSettingsData &item : nodes.data)
+    {
+        if (item.offset < 0 || item.changed || item.evicted ||
+            (std::exchange(item.accessed, false) && !all))
+            continue;
+
+        item.evictedSize = item.properties.release();
+        size += item.evictedSize;
+        item.evicted = true;
+    }
+
+    evicted += size;
+
+    return size;
+}
+
 void QLoaderTreePrivate::emitSettingsChanged()
 {
     mutex.lock();
     modified = true;
     mutex.unlock();
 
-    emit q_ptr->settingsChanged();
+    notify();
 }
 
-void QLoaderTreePrivate::dumpRecursive(QLoaderSettings *settings) const
+void QLoaderTreePrivate::dumpRecursive(QLoaderSettings *settings, const QString &section)
 {
-    qDebug().noquote().nospace() << u'[' << hash.data[settings].section << u']';
-    qDebug().noquote() << u"class ="_s << hash.data[settings].className;
+    materialize(node(settings));
 
-    if (hash.data[settings].pluginName.size())
-        qDebug().noquote() << u"plugin ="_s << hash.data[settings].pluginName;
+    qDebug().noquote().nospace() << u'[' << section << u']';
+    qDebug().noquote() << u"class ="_s << node(settings).className;
 
-    QMapIterator<QString, QLoaderProperty> i(hash.data[settings].properties);
-    while (i.hasNext())
-    {
-        i.next();
-        qDebug().noquote() << i.key() << '=' << i.value();
-    }
+    if (node(settings).pluginName.size())
+        qDebug().noquote() << u"plugin ="_s << node(settings).pluginName;
+
+    if (node(settings).base)
+        qDebug().noquote() << u"template ="_s << this->section(node(settings).base);
+
+    const QLoaderPropertyMap &properties = node(settings).properties;
+    for (auto i = properties.cbegin(), end = properties.cend(); i != end; ++i)
+        qDebug().noquote() << i.key().toString() << '=' << QString::fromUtf8(i.value());
 
     qDebug() << "";
 
-    for (QLoaderSettings *child : hash.data[settings].children)
-        dumpRecursive(child);
+    for (QLoaderSettings *child : node(settings).children)
+        dumpRecursive(child, section + u'/' + node(child).name.toString());
 }
 
-void QLoaderTreePrivate::dump(QLoaderSettings *settings) const
+void QLoaderTreePrivate::dump(QLoaderSettings *settings)
 {
     if (d.shebang.size())
         qDebug().noquote() << d.shebang;
 
-    dumpRecursive(settings);
+    dumpRecursive(settings, section(settings));
+}
+
+void QLoaderTreePrivate::instantiateRecursive(QLoaderSettings *base, QLoaderSettings *parent)
+{
+    const QList<QLoaderSettings *> children = node(base).children;
+    for (QLoaderSettings *child : children)
+    {
+        if (this->child(parent, node(child).name))
+            continue;
+
+        QLoaderSettings *settings = newSettings();
+
+        QLoaderSettingsData item;
+        item.parent = parent;
+        item.sectionLine = node(parent).sectionLine;
+        item.name = node(child).name;
+        item.level = node(parent).level + 1;
+        item.className = node(child).className;
+        item.pluginName = node(child).pluginName;
+        item.included = node(parent).included;
+        item.generated = true;
+
+        insertChild(parent, settings, item.name);
+        node(settings) = std::move(item);
+        setBase(settings, child);
+
+        instantiateRecursive(child, settings);
+    }
 }
 
 QLoaderError QLoaderTreePrivate::loadRecursive(QLoaderSettings *settings, QObject *parent)
@@ -514,12 +1194,16 @@ QLoaderError QLoaderTreePrivate::loadRecursive(QLoaderSettings *settings, QObjec
     QLoaderError error;
 
     mutex.lock();
-    const char *itemClassName = hash.data[settings].className;
+    const char *itemClassName = node(settings).className;
+    QLoaderStaticSection::Factory factory = node(settings).factory;
     mutex.unlock();
 
+    if (factory == QLoaderStaticSection::Unresolved)
+        factory = QLoaderStaticSection::factoryOf(itemClassName);
+
     QObject *object;
-    if (!strncmp(itemClassName, "QLoader", 7))
-        object = builtin(settings, parent);
+    if (factory != QLoaderStaticSection::External)
+        object = builtin(factory, settings, parent);
     else
         object = external(error, settings, parent);
 
@@ -527,8 +1211,8 @@ QLoaderError QLoaderTreePrivate::loadRecursive(QLoaderSettings *settings, QObjec
        return error;
 
     mutex.lock();
-    int itemSectionSize = hash.data[settings].section.count(u'/') + 1;
-    int itemSectionLine = hash.data[settings].sectionLine;
+    int itemSectionSize = node(settings).level;
+    int itemSectionLine = node(settings).sectionLine;
     mutex.unlock();
 
     if (object == parent || object == q_ptr ||
@@ -592,7 +1276,7 @@ QLoaderError QLoaderTreePrivate::loadRecursive(QLoaderSettings *settings, QObjec
         mutex.unlock();
 
     mutex.lock();
-    QList<QLoaderSettings *> children = hash.data[settings].children;
+    QList<QLoaderSettings *> children = node(settings).children;
     mutex.unlock();
 
     for (QLoaderSettings *child : children)
@@ -605,22 +1289,48 @@ QLoaderError QLoaderTreePrivate::loadRecursive(QLoaderSettings *settings, QObjec
     return error;
 }
 
-void QLoaderTreePrivate::moveRecursive(QLoaderSettings *settings,
-                                       const QLoaderTreeSection &src,
-                                       const QLoaderTreeSection &dst)
+void QLoaderTreePrivate::moveRecursive(QLoaderSettings *settings, int level, QLoaderTransactionPrivate::Undo *undo)
+{
+    QLoaderSettingsData &item = node(settings);
+    item.level = level;
+
+    if (item.included && !isIncludedParent(item.parent))
+    {
+        item.included = false;
+        if (undo)
+            undo->included.append(settings);
+    }
+
+    if (item.generated && !isGenerated(settings))
+    {
+        item.generated = false;
+        if (undo)
+            undo->generated.append(settings);
+    }
+
+    for (QLoaderSettings *child : std::as_const(item.children))
+        moveRecursive(child, level + 1, undo);
+}
+
+bool QLoaderTreePrivate::pluginLibrary(QLoaderSettings *settings, QString &libraryName)
 {
-    QLoaderSettingsData &item = hash.data[settings];
+    mutex.lock();
+    QString pluginName = node(settings).pluginName;
+    mutex.unlock();
 
-    QString sectionString = QLoaderTreeSectionAction<Move>::section(item.section.split(u'/'),
-                                                                    src.section.toString().split(u'/'),
-                                                                    dst.section.toString().split(u'/'));
+    libraryName = d.libraryPrefix;
+    if (pluginName.size())
+    {
+        libraryName += pluginName;
+        return true;
+    }
 
-    hash.settings.sections.remove(item.section);
-    hash.settings.sections[sectionString] = settings;
-    item.section = std::move(sectionString);
+    return d.parser.matchClassName(settings->className(), libraryName);
+}
 
-    for (QLoaderSettings *child : std::as_const(hash.data[settings].children))
-        moveRecursive(child, src, dst);
+QLoaderSettings *QLoaderTreePrivate::newSettings()
+{
+    return new (arena.allocate()) QLoaderSettings(*this);
 }
 
 QLoaderShell *QLoaderTreePrivate::newShellInstance()
@@ -629,24 +1339,24 @@ QLoaderShell *QLoaderTreePrivate::newShellInstance()
     {
         if (!d.shell.settings)
         {
-            d.shell.settings = new QLoaderSettings(*this);
-            hash.data[d.shell.settings] = {};
+            d.shell.settings = newSettings();
+            node(d.shell.settings) = {};
         }
         QLoaderShell *const shell = new QLoaderShell(d.shell.settings);
         emit q_ptr->errorChanged(shell, u"shell not loaded"_s);
         return shell;
     }
 
-    QLoaderShell *const shell = new QLoaderShell(hash.data[d.shell.settings].settings.front());
+    QLoaderShell *const shell = new QLoaderShell(node(d.shell.settings).settings.front());
     mutex.lock();
-    const int settings_size = int(hash.data[d.shell.settings].children.size());
+    const int settings_size = int(node(d.shell.settings).children.size());
     mutex.unlock();
 
     for (int o = 0, s = 0; s < settings_size; ++o, ++s)
     {
         mutex.lock();
         QObject *object = d.shell.object->children()[o];
-        QLoaderSettings *settings = hash.data[hash.data[d.shell.settings].children[s]].settings.front();
+        QLoaderSettings *settings = node(node(d.shell.settings).children[s]).settings.front();
         mutex.unlock();
 
         if (qobject_cast<QLoaderCommandInterface *>(object))
@@ -661,392 +1371,1422 @@ QLoaderShell *QLoaderTreePrivate::newShellInstance()
     return shell;
 }
 
-QLoaderError QLoaderTreePrivate::readSettings()
+void QLoaderTreePrivate::notify()
 {
-    QLoaderError error;
-    if (!file->open(QIODevice::ReadOnly | QIODevice::Text))
+    mutex.lock();
+    const QList<QLoaderNotification> pending = std::exchange(changes.pending, {});
+    mutex.unlock();
+
+    emit q_ptr->settingsChanged();
+
+    for (const QLoaderNotification &notification : pending)
     {
-        error.status = QLoaderError::Access;
-        error.message = u"read error"_s;
-        return error;
+        if (QObject *context = notification.context)
+            QMetaObject::invokeMethod(context, [notification] { notification.function(notification.change); });
     }
+}
+
+bool QLoaderTreePrivate::readCompiled(const CompiledHeader &source)
+{
+    QFile cache(compiledFileName(file->fileName()));
+    if (!cache.open(QIODevice::ReadOnly) || !cache.size())
+        return false;
 
-    QTextStream in(file);
-    QString line;
-    line.reserve(10240);
-    int currentLine{};
+    QByteArray buffer;
+    uchar *map = cache.map(0, cache.size());
+    if (map)
+        buffer = QByteArray::fromRawData(reinterpret_cast<const char *>(map), cache.size());
+    else
+        buffer = cache.readAll();
 
-    const QLatin1StringView shebang("#!"_L1);
-    const QChar comment('#'_L1);
+    QDataStream in(buffer);
+    in.setVersion(QDataStream::Qt_6_8);
 
-    QLoaderSettings *settings{};
-    QLoaderSettingsData item;
+    quint32 magic{}, version{};
+    CompiledHeader header;
+    in >> magic >> version >> header.size >> header.modified >> header.digest;
+
+    QString shebang;
+    quint32 count{};
+    in >> shebang >> count;
+
+    bool valid = (in.status() == QDataStream::Ok &&
+                  magic == CompiledHeader::magic &&
+                  version == CompiledHeader::version &&
+                  header == source &&
+                  count > 0);
 
-    while (!in.atEnd())
+    QList<QLoaderSettingsData> items;
+    QStringList paths;
+    QStringList bases;
+    QSet<QStringView> sections;
+
+    for (quint32 i = 0; valid && i < count; ++i)
     {
-        in.readLineInto(&line);
-        ++currentLine;
+        QString section, base;
+        QLoaderSettingsData item;
+        quint32 properties{};
+        in >> section >> item.sectionLine >> item.className >> item.pluginName
+           >> base >> item.included >> item.generated >> properties;
+        item.level = section.count(u'/') + 1;
+
+        for (quint32 p = 0; p < properties && in.status() == QDataStream::Ok; ++p)
+        {
+            QByteArray key, value;
+            in >> key >> value;
+            item.properties.insert(atoms.insert(key), value);
+        }
 
-        if (currentLine == 1 && line.startsWith(shebang))
+        if (in.status() != QDataStream::Ok ||
+            item.className.isEmpty() ||
+            sections.contains(section) ||
+            (i == 0) != (item.level == 1) ||
+            (i > 0 && !sections.contains(parentSection(section))))
         {
-            d.shebang = line;
-            continue;
+            valid = false;
+            break;
         }
 
-        if (line.isEmpty())
-            continue;
+        item.name = atoms.insert(objectName(section));
+        sections.insert(section);
+        paths.append(std::move(section));
+        bases.append(std::move(base));
+        items.append(std::move(item));
+    }
 
-        if (line.startsWith(comment))
-            continue;
+    if (map)
+        cache.unmap(map);
+
+    if (!valid)
+        return false;
+
+    for (qsizetype i = 0; i < items.size(); ++i)
+    {
+        QLoaderSettingsData &item = items[i];
+        QLoaderSettings *settings = newSettings();
 
-        QString section;
-        if (d.parser.matchSectionName(line, section))
+        if (item.level == 1)
+            d.root.settings = settings;
+        else
         {
-            QStringView name = objectName(section);
-            int level = section.count(u'/') + 1;
+            item.parent = find(parentSection(paths.at(i)));
+            insertChild(item.parent, settings, item.name);
+        }
 
-            if (settings)
-            {
-                if (item.className.isEmpty())
-                {
-                    error.line = item.sectionLine;
-                    error.status = QLoaderError::Design;
-                    error.message = u"class name not set"_s;
-                    break;
-                }
-                hash.data[settings] = std::move(item);
-            }
 
-            settings = new QLoaderSettings(*this);
+        if (item.className == "QLoaderShell")
+            d.shell.settings = settings;
 
-            bool valid{};
+        node(settings) = std::move(item);
+    }
 
-            if (!hash.settings.sections.contains(section))
-            {
-                hash.settings.sections[section] = settings;
+    for (qsizetype i = 0; i < bases.size(); ++i)
+    {
+        if (bases.at(i).size())
+            setBase(find(paths.at(i)), find(bases.at(i)));
+    }
 
-                if (level == 1 && name.size())
-                {
-                    if (!d.root.settings)
-                        valid = true;
-                    else
-                        error.message = u"root object already set"_s;
-                }
-                else if (d.root.settings && level > 1 && name.size())
-                {
-                    QStringView parent = parentSection(section);
+    d.shebang = std::move(shebang);
 
-                    if (hash.settings.sections.contains(parent))
-                    {
-                        valid = true;
-                        item.parent = hash.settings.sections.value(parent);
-                        hash.data[item.parent].children.push_back(settings);
-                    }
-                }
-                else
-                    error.message = u"section not valid"_s;
-            }
-            else
-            {
-                error.message = u"section already set"_s;
-                delete settings;
-            }
+    return true;
+}
 
-            item.section = std::move(section);
-            item.sectionLine = currentLine;
-            item.level = level;
+bool QLoaderTreePrivate::readCbor(SettingsReader &reader, QByteArrayView data)
+{
+    QCborStreamReader in(QByteArray::fromRawData(data.data(), data.size()));
+    if (in.isTag() && in.toTag() == QCborKnownTags::Signature)
+        in.next();
 
-            if (!valid)
-            {
-                error.line = currentLine;
-                error.status = QLoaderError::Design;
-                if (error.message.isEmpty())
-                    error.message = u"section not valid"_s;
+    int line{};
+    auto read = [&reader, &line, this](SettingsLine::Type type, QByteArrayView key, QByteArrayView value)
+    {
+        return readLine(reader, SettingsLine{.line = line, .type = type, .key = key, .value = value});
+    };
 
-                break;
-            }
+    bool valid = in.isMap() && in.enterContainer();
+    while (valid && in.hasNext())
+    {
+        QByteArray key, value;
+        if (!(valid = readCborString(in, key)))
+            break;
 
-            continue;
+        if (key == "shebang")
+        {
+            valid = readCborString(in, value);
+            d.shebang = QString::fromUtf8(value);
         }
-
-        QString key, value;
-        if (d.parser.matchKeyValue(line, key, value))
+        else if (key == "sections" && in.isArray())
         {
-            if (item.section.isEmpty())
-            {
-                error.line = item.sectionLine;
-                error.status = QLoaderError::Format;
-                error.message = u"section not set"_s;
-                break;
-            }
-
-            if (key == "class"_L1)
+            valid = in.enterContainer();
+            while (valid && in.hasNext())
             {
-                if (item.className.size())
-                {
-                    error.line = item.sectionLine;
-                    error.status = QLoaderError::Format;
-                    error.message = u"class already set"_s;
-                    break;
-                }
-
-                if (!d.root.settings && item.level == 1)
-                    d.root.settings = settings;
-
-                item.className = value.toLocal8Bit();
-                if (!strncmp(item.className.data(), "Loader", 6))
-                {
-                    error.line = item.sectionLine;
-                    error.status = QLoaderError::Object;
-                    error.message = u"class not found"_s;
-                    break;
-                }
+                ++line;
+                QByteArray section;
+                QList<std::pair<QByteArray, QByteArray>> keyValues;
 
-                bool isShell{};
-                const char *shortName = item.className.data() + std::char_traits<char>::length("QLoader");
-                if ((isShell = !strcmp(shortName, "Shell")))
+                valid = in.isMap() && in.enterContainer();
+                while (valid && in.hasNext())
                 {
-                    if (item.level > 2)
-                    {
-                        error.line = item.sectionLine;
-                        error.status = QLoaderError::Design;
-                        error.message = u"parent object not valid"_s;
+                    if (!(valid = readCborString(in, key)))
                         break;
-                    }
 
-                    if (isShell && d.shell.settings)
+                    if (key == "properties")
                     {
-                        error.line = item.sectionLine;
-                        error.status = QLoaderError::Design;
-                        error.message = u"shell object already set"_s;
-                        break;
+                        valid = in.isMap() && in.enterContainer();
+                        while (valid && in.hasNext())
+                        {
+                            if ((valid = readCborString(in, key) && readCborString(in, value)))
+                                keyValues.append({key, value});
+                        }
+
+                        valid = valid && in.leaveContainer();
                     }
-
-                    if (isShell)
-                        d.shell.settings = settings;
+                    else if (!(valid = readCborString(in, value)))
+                        break;
+                    else if (key == "section")
+                        section = value;
+                    else
+                        keyValues.append({key, value});
                 }
-            }
-            else if (key == "plugin"_L1)
-            {
-                if (item.pluginName.size())
+
+                valid = valid && in.leaveContainer() && section.size();
+                if (valid && !read(SettingsLine::Section, section, {}))
+                    return false;
+
+                for (qsizetype i = 0; valid && i < keyValues.size(); ++i)
                 {
-                    error.line = item.sectionLine;
-                    error.status = QLoaderError::Format;
-                    error.message = u"plugin already set"_s;
-                    break;
+                    if (!read(SettingsLine::KeyValue, keyValues.at(i).first, keyValues.at(i).second))
+                        return false;
                 }
-
-                item.pluginName = value;
-            }
-            else if (!item.properties.contains(key))
-                item.properties[key] = std::move(value);
-            else
-            {
-                error.status = QLoaderError::Design;
-                error.message = u"key \""_s + key + u"\" already set"_s;
-                break;
             }
 
-            continue;
-        }
-
-        if (error.message.isEmpty())
-        {
-            error.line = currentLine;
-            error.status = QLoaderError::Format;
-            error.message = u"string not valid"_s;
+            valid = valid && in.leaveContainer();
         }
-
-        break;
+        else
+            valid = in.next();
     }
 
-    hash.data[settings] = std::move(item);
+    if (!valid || in.lastError() != QCborError::NoError)
+    {
+        reader.error.line = line;
+        reader.error.status = QLoaderError::Format;
+        reader.error.message = u"CBOR data not valid"_s;
+        return false;
+    }
 
-    return error;
+    return true;
 }
 
-QLoaderError QLoaderTreePrivate::load()
+bool QLoaderTreePrivate::readInclude(SettingsReader &reader, QLoaderSettings *settings)
 {
-    QLoaderError error;
-    d.loading.lock();
-    do
+    QLoaderError &error = reader.error;
+    const QLoaderSettingsData &item = node(settings);
+    const int sectionLine = item.sectionLine;
+
+    QString base = reader.includes.isEmpty() ? file->fileName() : reader.includes.last();
+    QString fileName = QFileInfo(QFileInfo(base).absoluteDir(), item.include).canonicalFilePath();
+
+    std::shared_ptr<const SettingsInclude> include;
+    if (fileName.isEmpty() || !(include = SettingsInclude::open(fileName)))
     {
-        if (loaded)
-        {
-            error.status = QLoaderError::Object;
+        error.line = sectionLine;
+        error.status = QLoaderError::Access;
+        error.message = u"include \""_s + item.include + u"\" not found"_s;
+        return false;
+    }
+
+    if (reader.includes.contains(fileName))
+    {
+        error.line = sectionLine;
+        error.status = QLoaderError::Design;
+        error.message = u"include \""_s + item.include + u"\" recursive"_s;
+        return false;
+    }
+
+    const QByteArray prefix = section(settings).toUtf8() + '/';
+    reader.includes.append(fileName);
+    reader.included = true;
+
+    auto includeError = [&error, &fileName]
+    {
+        error.message += u" in \""_s + fileName + u'"';
+        return false;
+    };
+
+    for (SettingsLine line : include->lines)
+    {
+        QByteArray path;
+        if (line.type == SettingsLine::Section)
+            line.key = (path = prefix + line.key.toByteArray());
+
+        if (!readLine(reader, line))
+            return includeError();
+    }
+
+    if (!endSection(reader))
+        return includeError();
+
+    reader.includes.removeLast();
+
+    return true;
+}
+
+bool QLoaderTreePrivate::readLine(SettingsReader &reader, const SettingsLine &line)
+{
+    QLoaderError &error = reader.error;
+    QLoaderSettingsData &item = reader.item;
+    QLoaderSettings *&settings = reader.settings;
+
+    if (line.type == SettingsLine::Section)
+    {
+        QByteArrayView section = line.key;
+        QByteArrayView name = objectName(section);
+        int level = int(section.count('/')) + 1;
+
+        if (!endSection(reader))
+            return false;
+
+        settings = newSettings();
+
+        bool valid{};
+        QLoaderSettings *parent = (level > 1 ? find(parentSection(section)) : nullptr);
+        QLoaderAtom atom = atoms.insert(name);
+
+        if ((level == 1 || parent) && child(parent, atom))
+            error.message = u"section already set"_s;
+        else if (level == 1 && name.size())
+        {
+            if (!d.root.settings)
+                valid = true;
+            else
+                error.message = u"root object already set"_s;
+        }
+        else if (d.root.settings && level > 1 && name.size())
+        {
+            if (parent)
+            {
+                valid = true;
+                item.parent = parent;
+                insertChild(item.parent, settings, atom);
+            }
+        }
+        else
+            error.message = u"section not valid"_s;
+
+        item.name = atom;
+        item.sectionLine = line.line;
+        item.level = level;
+        item.included = !reader.includes.isEmpty();
+        item.offset = (item.included || compressed ? -1 : line.offset);
+
+        if (!valid)
+        {
+            deleteSettings(settings);
+            settings = nullptr;
+
+            error.line = line.line;
+            error.status = QLoaderError::Design;
+            if (error.message.isEmpty())
+                error.message = u"section not valid"_s;
+
+            return false;
+        }
+
+        return true;
+    }
+
+    if (line.type == SettingsLine::KeyValue)
+    {
+        if (item.name.isNull())
+        {
+            error.line = item.sectionLine;
+            error.status = QLoaderError::Format;
+            error.message = u"section not set"_s;
+            return false;
+        }
+
+        if (line.key == "class")
+        {
+            if (item.className.size())
+            {
+                error.line = item.sectionLine;
+                error.status = QLoaderError::Format;
+                error.message = u"class already set"_s;
+                return false;
+            }
+
+            if (!d.root.settings && item.level == 1)
+                d.root.settings = settings;
+
+            item.className = line.value.toByteArray();
+            if (!strncmp(item.className.data(), "Loader", 6))
+            {
+                error.line = item.sectionLine;
+                error.status = QLoaderError::Object;
+                error.message = u"class not found"_s;
+                return false;
+            }
+
+            bool isShell{};
+            const char *shortName = item.className.data() + std::char_traits<char>::length("QLoader");
+            if ((isShell = !strcmp(shortName, "Shell")))
+            {
+                int includeLevel{};
+                for (QLoaderSettings *parent = item.parent; item.included && parent; parent = node(parent).parent)
+                {
+                    if (node(parent).include.size())
+                    {
+                        includeLevel = node(parent).level;
+                        break;
+                    }
+                }
+
+                if (item.level - includeLevel > 2)
+                {
+                    error.line = item.sectionLine;
+                    error.status = QLoaderError::Design;
+                    error.message = u"parent object not valid"_s;
+                    return false;
+                }
+
+                const bool included = d.shell.settings && node(d.shell.settings).included;
+                if (d.shell.settings && !item.included && !included)
+                {
+                    error.line = item.sectionLine;
+                    error.status = QLoaderError::Design;
+                    error.message = u"shell object already set"_s;
+                    return false;
+                }
+
+                if (!d.shell.settings || (!item.included && included))
+                    d.shell.settings = settings;
+            }
+        }
+        else if (line.key == "plugin")
+        {
+            if (item.pluginName.size())
+            {
+                error.line = item.sectionLine;
+                error.status = QLoaderError::Format;
+                error.message = u"plugin already set"_s;
+                return false;
+            }
+
+            item.pluginName = QString::fromUtf8(line.value);
+        }
+        else if (line.key == "template")
+        {
+            if (reader.hasTemplate())
+            {
+                error.line = item.sectionLine;
+                error.status = QLoaderError::Format;
+                error.message = u"template already set"_s;
+                return false;
+            }
+
+            reader.templates.append({.settings = settings, .section = line.value.toByteArray(), .line = item.sectionLine});
+        }
+        else if (line.key == "include")
+        {
+            if (item.include.size())
+            {
+                error.line = item.sectionLine;
+                error.status = QLoaderError::Format;
+                error.message = u"include already set"_s;
+                return false;
+            }
+
+            item.include = QString::fromUtf8(line.value);
+        }
+        else
+            return readProperty(reader, atoms.insert(line.key), line.value.toByteArray());
+
+        return true;
+    }
+
+    error.line = line.line;
+    error.status = QLoaderError::Format;
+    error.message = u"string not valid"_s;
+
+    return false;
+}
+
+bool QLoaderTreePrivate::readProperty(SettingsReader &reader, QLoaderAtom key, QByteArray &&value)
+{
+    QLoaderError &error = reader.error;
+    QLoaderSettingsData &item = reader.item;
+
+    if (item.name.isNull())
+    {
+        error.line = item.sectionLine;
+        error.status = QLoaderError::Format;
+        error.message = u"section not set"_s;
+        return false;
+    }
+
+    if (item.properties.contains(key))
+    {
+        error.status = QLoaderError::Design;
+        error.message = u"key \""_s + key.toString() + u"\" already set"_s;
+        return false;
+    }
+
+    item.properties.insert(key, value);
+
+    return true;
+}
+
+QLoaderError QLoaderTreePrivate::readSettings()
+{
+    if (staticTree)
+        return readStatic();
+
+    QLoaderError error;
+    if (!file->open(QIODevice::ReadOnly))
+    {
+        error.status = QLoaderError::Access;
+        error.message = u"read error"_s;
+        return error;
+    }
+
+    QByteArray buffer;
+    fileSize = file->size();
+    fileModified = file->fileTime(QFileDevice::FileModificationTime).toMSecsSinceEpoch();
+    uchar *map = fileSize ? file->map(0, fileSize) : nullptr;
+    if (!map && fileSize)
+        buffer = file->readAll();
+
+    QByteArrayView data = map ? QByteArrayView(map, fileSize) : QByteArrayView(buffer);
+
+    const qsizetype bodyStart = data.startsWith("#!") ? data.indexOf('\n') + 1 : 0;
+    compressed = data.sliced(bodyStart).startsWith("\x1f\x8b");
+    cbor = data.startsWith("\xd9\xd9\xf7");
+
+    CompiledHeader compiled;
+    if (loadOptions.testFlag(QLoaderTree::UseCompiledCache))
+    {
+        compiled.size = fileSize;
+        compiled.modified = fileModified;
+        compiled.digest = QCryptographicHash::hash(data, QCryptographicHash::Md5);
+
+        if (readCompiled(compiled))
+        {
+            if (map)
+                file->unmap(map);
+
+            return error;
+        }
+    }
+
+    SettingsReader reader;
+
+    if (cbor)
+        readCbor(reader, data);
+    else if (compressed)
+    {
+        GzipDevice gzip(data.sliced(bodyStart));
+        gzip.open(QIODevice::ReadOnly);
+
+        SettingsParser parser;
+        parser.read = [&reader, this, offset = int(bodyStart > 0)](SettingsLine &&line)
+        {
+            line.line += offset;
+            return readLine(reader, line);
+        };
+
+        parser.parse(&gzip);
+        d.shebang = QString::fromUtf8(data.first(bodyStart)).trimmed();
+
+        if (!reader.error && gzip.status != Z_STREAM_END)
+        {
+            reader.error.status = QLoaderError::Format;
+            reader.error.message = u"compressed data not valid"_s;
+        }
+    }
+    else if (loadOptions.testFlag(QLoaderTree::ParallelParse))
+    {
+        QList<SettingsChunk> chunks = SettingsChunk::split(data);
+
+        QThreadPool pool;
+        pool.setMaxThreadCount(int(chunks.size()));
+        for (SettingsChunk &chunk : chunks)
+            pool.start([&chunk] { chunk.read(); });
+        pool.waitForDone();
+
+        if (chunks.size())
+            d.shebang = std::move(chunks.front().shebang);
+
+        int currentLine{};
+        for (SettingsChunk &chunk : chunks)
+        {
+            QList<QLoaderAtom> keys;
+            keys.reserve(chunk.keys.size());
+            for (QByteArrayView key : std::as_const(chunk.keys))
+                keys.append(atoms.insert(key));
+
+            bool valid = true;
+            for (SettingsChunk::Entry &entry : chunk.entries)
+            {
+                SettingsLine &line = entry.line;
+                line.line += currentLine;
+                if (line.type == SettingsLine::Section)
+                    line.offset += chunk.data.data() - data.data();
+
+                if (entry.key == -1)
+                    valid = readLine(reader, line);
+                else
+                    valid = readProperty(reader, keys.at(entry.key), std::move(entry.value));
+
+                if (!valid)
+                    break;
+            }
+
+            if (!valid)
+                break;
+
+            currentLine += chunk.lineCount;
+        }
+    }
+    else
+    {
+        SettingsParser parser;
+        parser.read = [&reader, this](SettingsLine &&line) { return readLine(reader, line); };
+
+        parser.parse(data);
+        d.shebang = std::move(parser.shebangLine);
+    }
+
+    if (!reader.error && endSection(reader))
+        readTemplates(reader);
+
+    if (reader.settings)
+        node(reader.settings) = std::move(reader.item);
+
+    error = reader.error;
+
+    if (map)
+        file->unmap(map);
+
+    if (!error && d.root.settings && !reader.included && !checking &&
+        loadOptions.testFlag(QLoaderTree::UseCompiledCache))
+        writeCompiled(compiled);
+
+    return error;
+}
+
+QLoaderError QLoaderTreePrivate::readStatic()
+{
+    SettingsReader reader;
+    bool valid = true;
+
+    for (int i = 0; valid && i < staticTree->sectionCount; ++i)
+    {
+        const QLoaderStaticSection &section = staticTree->sections[i];
+        if (!(valid = readLine(reader, {.line = section.line, .type = SettingsLine::Section, .key = section.section})))
+            break;
+
+        reader.item.factory = section.factory;
+
+        const QLoaderStaticProperty *property = staticTree->properties + section.firstProperty;
+        for (int p = 0; valid && p < section.propertyCount; ++p, ++property)
+        {
+            if (isReservedKey(property->key))
+            {
+                valid = readLine(reader, {.line = property->line,
+                                          .type = SettingsLine::KeyValue,
+                                          .key = property->key,
+                                          .value = property->value});
+            }
+            else
+            {
+                valid = readProperty(reader,
+                                     atoms.insert(property->key),
+                                     QByteArray::fromRawData(property->value.data(), property->value.size()));
+            }
+        }
+    }
+
+    if (!reader.error && endSection(reader))
+        readTemplates(reader);
+
+    if (reader.settings)
+        node(reader.settings) = std::move(reader.item);
+
+    d.shebang = QString::fromUtf8(staticTree->shebang);
+
+    return reader.error;
+}
+
+bool QLoaderTreePrivate::readTemplates(SettingsReader &reader)
+{
+    auto contains = [this](QLoaderSettings *ancestor, QLoaderSettings *settings)
+    {
+        for (; settings; settings = node(settings).parent)
+        {
+            if (settings == ancestor)
+                return true;
+        }
+
+        return false;
+    };
+
+    QList<SettingsTemplate> &templates = reader.templates;
+    while (templates.size())
+    {
+        qsizetype ready{-1};
+        QLoaderSettings *base{};
+        for (qsizetype i = 0; ready == -1 && i < templates.size(); ++i)
+        {
+            if (!(base = find(QByteArrayView(templates.at(i).section))))
+                continue;
+
+            ready = i;
+            for (const SettingsTemplate &pending : std::as_const(templates))
+            {
+                if (contains(base, pending.settings))
+                {
+                    ready = -1;
+                    break;
+                }
+            }
+        }
+
+        const SettingsTemplate entry = templates.at(ready == -1 ? 0 : ready);
+        if (ready == -1 || contains(entry.settings, base) || node(base).className == "QLoaderShell")
+        {
+            reader.error.line = entry.line;
+            reader.error.status = QLoaderError::Design;
+            reader.error.message = u"template not valid"_s;
+            return false;
+        }
+
+        templates.removeAt(ready);
+
+        setBase(entry.settings, base);
+        QLoaderSettingsData &item = node(entry.settings);
+
+        if (item.className.isEmpty())
+            item.className = node(base).className;
+
+        if (item.pluginName.isEmpty())
+            item.pluginName = node(base).pluginName;
+
+        instantiateRecursive(base, entry.settings);
+    }
+
+    return true;
+}
+
+QLoaderError QLoaderTreePrivate::load()
+{
+    QLoaderError error;
+    d.loading.lock();
+    do
+    {
+        if (loaded)
+        {
+            error.status = QLoaderError::Object;
             error.message = u"already loaded"_s;
             break;
         }
 
-        if ((error = readSettings()))
-            break;
+        if (!parsed)
+            parsed = readSettings();
+
+        if ((error = *parsed))
+            break;
+
+        if (d.shell.settings && (error = loadRecursive(d.shell.settings, q_ptr)))
+            break;
+
+        bool coreApp = !qobject_cast<QApplication *>(QCoreApplication::instance());
+        if ((error = loadRecursive(d.root.settings, coreApp ? q_ptr : nullptr)))
+            break;
+
+        loaded = true;
+
+        mutex.lock();
+        resetSnapshot();
+        publishSnapshot();
+        mutex.unlock();
+
+        if (loadOptions.testFlag(QLoaderTree::LowMemory))
+        {
+            mutex.lock();
+            evict(true);
+            mutex.unlock();
+        }
+
+    } while (0);
+
+    if (!loaded)
+    {
+        file->close();
+        if (d.root.object) delete d.root.object;
+    }
+
+    d.loading.unlock();
+
+    if (loaded)
+        emit q_ptr->loaded();
+
+    return error;
+}
+
+void QLoaderTreePrivate::insertChild(QLoaderSettings *parent, QLoaderSettings *settings, QLoaderAtom name, qsizetype index)
+{
+    QList<QLoaderSettings *> &children = node(parent).children;
+    children.insert(index < 0 ? children.size() : index, settings);
+    nodes.children.insert({parent, name}, settings);
+    resetSnapshot(parent->node);
+    resetSnapshot(settings->node);
+}
+
+int QLoaderTreePrivate::insertNode(QLoaderSettings *settings)
+{
+    if (nodes.free.size())
+    {
+        int node = nodes.free.takeLast();
+        nodes.settings[node] = settings;
+        resetSnapshot(node);
+        return node;
+    }
+
+    nodes.data.emplace_back();
+    nodes.settings.append(settings);
+    nodes.generations.append(0);
+    resetSnapshot(int(nodes.settings.size() - 1));
+
+    return int(nodes.settings.size() - 1);
+}
+
+bool QLoaderTreePrivate::materialize(QLoaderSettingsData &item)
+{
+    item.accessed = true;
+    if (!item.evicted)
+        return true;
+
+    if (isFileChanged())
+    {
+        if (!std::exchange(item.stale, true))
+        {
+            QMetaObject::invokeMethod(q_ptr, [q = q_ptr, object = item.object]
+            {
+                emit q->errorChanged(object, u"file changed, evicted section lost"_s);
+            }, Qt::QueuedConnection);
+        }
+
+        return false;
+    }
+
+    item.evicted = false;
+    evicted -= std::exchange(item.evictedSize, 0);
+
+    int sections{};
+    SettingsParser parser;
+    parser.read = [&item, &sections, this](SettingsLine &&line)
+    {
+        if (line.type == SettingsLine::Section)
+            return !sections++;
+
+        if (line.type == SettingsLine::KeyValue && !isReservedKey(line.key))
+            item.properties.insert(atoms.insert(line.key), line.value.toByteArray());
+
+        return line.type != SettingsLine::Invalid;
+    };
+
+    if (file->seek(item.offset))
+        parser.parse(file);
+
+    return true;
+}
+
+QLoaderError QLoaderTreePrivate::move(QStringView section, QStringView to)
+{
+    QLoaderTreeSectionAction<Move> mv(section, to, this);
+
+    if (QLoaderError error = mv.error())
+        return error;
+
+    mutex.lock();
+    QLoaderSettingsData &item = node(mv.src.settings);
+    QString from = (changes.subscriptions.size() ? this->section(mv.src.settings) : QString());
+    QLoaderSettings *parent = item.parent;
+    removeChild(mv.src.parent.settings, mv.src.settings);
+    item.parent = mv.dst.parent.settings;
+    item.name = atoms.insert(objectName(mv.dst.section));
+    insertChild(mv.dst.parent.settings, mv.src.settings, item.name);
+    moveRecursive(mv.src.settings, node(mv.dst.parent.settings).level + 1);
+    publishSnapshot();
+    changed(QLoaderChange::Move, mv.src.settings, {}, from, parent);
+    mutex.unlock();
+
+    emitSettingsChanged();
+
+    return {};
+}
+
+QLoaderError QLoaderTreePrivate::load(const QStringList &/*section*/)
+{
+    if (loaded)
+        return {};
+    return {};
+}
+
+QVariant QLoaderTreePrivate::fromString(const QString &value) const
+{
+    return d.converter.fromString(value);
+}
+
+QString QLoaderTreePrivate::fromVariant(const QVariant &variant) const
+{
+    return d.converter.fromVariant(variant);
+}
+
+QLoaderSettings *QLoaderTreePrivate::find(QStringView section) const
+{
+    QLoaderSettings *settings{};
+    for (qsizetype from = 0, to; from <= section.size(); from = to + 1)
+    {
+        if ((to = section.indexOf(u'/', from)) == -1)
+            to = section.size();
+
+        if (!(settings = child(settings, atoms.find(section.sliced(from, to - from)))))
+            return nullptr;
+    }
+
+    return settings;
+}
+
+QLoaderSettings *QLoaderTreePrivate::find(QLoaderSectionHandle handle) const
+{
+    if (handle.node < 0 || handle.node >= nodes.settings.size() ||
+        nodes.generations.at(handle.node) != handle.generation)
+        return nullptr;
+
+    return nodes.settings.at(handle.node);
+}
+
+QLoaderSectionHandle QLoaderTreePrivate::handle(QLoaderSettings *settings) const
+{
+    return QLoaderSectionHandle(settings->node, nodes.generations.at(settings->node));
+}
+
+QLoaderSettings *QLoaderTreePrivate::find(QByteArrayView section) const
+{
+    QLoaderSettings *settings{};
+    for (qsizetype from = 0, to; from <= section.size(); from = to + 1)
+    {
+        if ((to = section.indexOf('/', from)) == -1)
+            to = section.size();
+
+        if (!(settings = child(settings, atoms.find(section.sliced(from, to - from)))))
+            return nullptr;
+    }
+
+    return settings;
+}
+
+const QLoaderProperty *QLoaderTreePrivate::property(QLoaderSettingsData &item, QLoaderAtom key)
+{
+    for (QLoaderSettingsData *data = &item; data; )
+    {
+        materialize(*data);
+        if (auto i = data->properties.constFind(key); i != data->properties.cend())
+            return &*i;
+
+        data = (data->base ? &node(data->base) : nullptr);
+    }
+
+    return nullptr;
+}
+
+QLoaderSettings *QLoaderTreePrivate::copyRecursive(QLoaderSettings *settings,
+                                                   QLoaderSettings *parent,
+                                                   QLoaderAtom name)
+{
+    QLoaderSettings *copySettings = newSettings();
+    d.copied.append(copySettings);
+    insertChild(parent, copySettings, name);
+
+    QLoaderSettingsData item;
+    item.parent = parent;
+    item.name = name;
+    item.level = node(parent).level + 1;
+    item.className = node(settings).className;
+    item.pluginName = node(settings).pluginName;
+    item.include = node(settings).include;
+    item.included = node(settings).included && isIncludedParent(parent);
+    item.generated = node(settings).generated;
+    item.properties = node(settings).properties;
+    node(copySettings) = std::move(item);
+    setBase(copySettings, node(settings).base);
+    node(copySettings).generated = isGenerated(copySettings);
+
+    const QList<QLoaderSettings *> children = node(settings).children;
+    for (QLoaderSettings *child : children)
+        copyRecursive(child, copySettings, node(child).name);
+
+    return copySettings;
+}
+
+void QLoaderTreePrivate::deleteRecursive(QLoaderSettings *settings)
+{
+    const QList<QLoaderSettings *> children = node(settings).children;
+    for (QLoaderSettings *child : children)
+        deleteRecursive(child);
+
+    deleteSettings(settings);
+}
+
+void QLoaderTreePrivate::deleteSettings(QLoaderSettings *settings)
+{
+    removeNode(settings);
+    settings->~QLoaderSettings();
+    arena.deallocate(settings);
+}
+
+QLoaderError QLoaderTreePrivate::copy(QStringView section, QStringView to)
+{
+    QLoaderTreeSectionAction<Copy> cp(section, to, this);
+
+    QLoaderError error;
+    if ((error = cp.error()))
+        return error;
+
+    mutex.lock();
+    QLoaderSettings *settings = copyRecursive(cp.src.settings,
+                                              cp.dst.parent.settings,
+                                              atoms.insert(objectName(cp.dst.section)));
+    QObject *parent = node(cp.dst.parent.settings).object;
+    changed(QLoaderChange::Copy, settings, {}, section.toString());
+    publishSnapshot();
+    mutex.unlock();
+
+    error = loadRecursive(settings, parent);
+
+    mutex.lock();
+    d.copied.clear();
+    mutex.unlock();
+
+    if (error.status)
+    {
+        mutex.lock();
+        removeRecursive(cp.dst.settings);
+        mutex.unlock();
+
+        return error;
+    }
+
+    emitSettingsChanged();
+
+    return {};
+}
+
+QLoaderError QLoaderTreePrivate::apply(const QLoaderTransactionPrivate::Operation &operation,
+                                       QList<QLoaderTransactionPrivate::Undo> &undo,
+                                       QList<QLoaderSettings *> &copies)
+{
+    QLoaderSettings *settings = find(QStringView(operation.section));
+    if (!settings)
+        return {.status = QLoaderError::Design, .message = u"section not valid: "_s + operation.section};
+
+    QLoaderSettingsData &item = node(settings);
+
+    if (operation.type == QLoaderTransactionPrivate::SetValue)
+    {
+        if (item.included)
+            return {.status = QLoaderError::Access, .message = u"section read-only: "_s + operation.section};
+
+        if (!materialize(item))
+            return {.status = QLoaderError::Access, .message = u"file changed: "_s + operation.section};
+        QLoaderAtom key = atoms.find(QStringView(operation.argument));
+        auto i = item.properties.constFind(key);
+        QLoaderTransactionPrivate::Undo entry{.type = operation.type,
+                                              .settings = settings,
+                                              .changed = item.changed};
+
+        if (i != item.properties.cend())
+            entry.utf8 = i.value();
+
+        QLoaderChange::Kind kind = (entry.utf8 ? QLoaderChange::Value : QLoaderChange::Add);
+
+        if (operation.value.isNull())
+        {
+            if (!entry.utf8)
+                return {};
+
+            item.properties.remove(key);
+            if (!this->property(item, key))
+                kind = QLoaderChange::Remove;
+        }
+        else
+        {
+            const QLoaderProperty *property = this->property(item, key);
+            if (property && property->utf8 == operation.utf8)
+                return {};
+
+            key = atoms.insert(QStringView(operation.argument));
+            item.properties.insert(key, operation.utf8);
+        }
+
+        entry.name = key;
+        item.changed = true;
+        item.views.clear();
+        resetSnapshot(settings->node);
+        undo.append(entry);
+        changed(kind, settings, operation.argument);
+
+        return {};
+    }
+
+    QStringView to(operation.argument);
+    QLoaderSettings *parent = find(parentSection(to));
+    QLoaderAtom name = atoms.insert(objectName(to));
+    QString path = u'[' + operation.section + u"] -> ["_s + operation.argument + u']';
 
-        if (d.shell.settings && (error = loadRecursive(d.shell.settings, q_ptr)))
-            break;
+    if (!item.parent || !parent || child(parent, name))
+        return {.status = QLoaderError::Design, .message = path + u" : section not valid"_s};
 
-        bool coreApp = !qobject_cast<QApplication *>(QCoreApplication::instance());
-        if ((error = loadRecursive(d.root.settings, coreApp ? q_ptr : nullptr)))
-            break;
+    for (QLoaderSettings *ancestor = parent; ancestor; ancestor = node(ancestor).parent)
+    {
+        if (ancestor == settings)
+            return {.status = QLoaderError::Design, .message = path + u" : section not valid"_s};
+    }
 
-        loaded = true;
+    if (operation.type == QLoaderTransactionPrivate::Copy)
+    {
+        QLoaderSettings *copySettings = copyRecursive(settings, parent, name);
+        copies.append(copySettings);
+        undo.append({.type = operation.type, .settings = copySettings});
+        changed(QLoaderChange::Copy, copySettings, {}, operation.section);
 
-    } while (0);
+        return {};
+    }
+
+    QList<QLoaderSettings *> &children = node(item.parent).children;
+    undo.append({.type = operation.type,
+                 .settings = settings,
+                 .parent = item.parent,
+                 .name = item.name,
+                 .index = children.indexOf(settings)});
+
+    removeChild(item.parent, settings);
+    insertChild(parent, settings, name);
+    item.parent = parent;
+    item.name = name;
+    moveRecursive(settings, node(parent).level + 1, &undo.last());
+    changed(QLoaderChange::Move, settings, {}, operation.section, undo.constLast().parent);
+
+    return {};
+}
+
+QLoaderError QLoaderTreePrivate::commit(QList<QLoaderTransactionPrivate::Operation> &operations)
+{
+    QList<QLoaderTransactionPrivate::Undo> undo;
+    QList<QLoaderSettings *> copies;
+    QLoaderError error;
+
+    if ((error = prepare(operations)))
+        return error;
 
+    mutex.lock();
     if (!loaded)
     {
-        file->close();
-        if (d.root.object) delete d.root.object;
+        mutex.unlock();
+        return {.status = QLoaderError::Object, .message = u"tree not loaded"_s};
     }
 
-    d.loading.unlock();
+    const qsizetype pending = changes.pending.size();
+    for (const QLoaderTransactionPrivate::Operation &operation : operations)
+    {
+        if ((error = apply(operation, undo, copies)))
+        {
+            rollback(undo);
+            changes.pending.resize(pending);
+            d.copied.clear();
+            mutex.unlock();
+            return error;
+        }
+    }
 
-    if (loaded)
-        emit q_ptr->loaded();
+    if (undo.size())
+    {
+        modified = true;
+        publishSnapshot();
+    }
+    mutex.unlock();
+
+    for (QLoaderSettings *settings : std::as_const(copies))
+    {
+        mutex.lock();
+        QLoaderSettings *parent = node(settings).parent;
+        while (parent && !copies.contains(parent))
+            parent = node(parent).parent;
+
+        QObject *object = node(node(settings).parent).object;
+        mutex.unlock();
+
+        if (!parent && (error = loadRecursive(settings, object)))
+            break;
+    }
+
+    mutex.lock();
+    d.copied.clear();
+    mutex.unlock();
+
+    if (undo.size())
+        notify();
 
     return error;
 }
 
-QLoaderError QLoaderTreePrivate::move(QStringView section, QStringView to)
+QLoaderError QLoaderTreePrivate::prepare(QList<QLoaderTransactionPrivate::Operation> &operations)
 {
-    QLoaderTreeSectionAction<Move> mv(section, to, this);
+    QList<std::pair<QString, QString>> moved;
+    auto origin = [&moved](QString section)
+    {
+        for (auto i = moved.crbegin(); i != moved.crend(); ++i)
+        {
+            if (section == i->first || section.startsWith(i->first + u'/'))
+                section = i->second + section.sliced(i->first.size());
+        }
 
-    if (QLoaderError error = mv.error())
-        return error;
+        return section;
+    };
 
-    mutex.lock();
-    hash.data[mv.src.parent.settings].children.removeOne(mv.src.settings);
-    hash.data[mv.dst.parent.settings].children.push_back(mv.src.settings);
-    moveRecursive(mv.src.settings, mv.src, mv.dst);
-    mutex.unlock();
+    for (QLoaderTransactionPrivate::Operation &operation : operations)
+    {
+        const QString section = origin(operation.section);
 
-    emitSettingsChanged();
+        mutex.lock();
+        QLoaderSettings *instance = find(QStringView(section));
+        if (instance && node(instance).settings.size())
+            instance = node(instance).settings.front();
+        mutex.unlock();
+
+        if (operation.type == QLoaderTransactionPrivate::SetValue)
+        {
+            if (!operation.value.isNull())
+                operation.utf8 = (instance ? instance->fromVariant(operation.value)
+                                           : fromVariant(operation.value)).toUtf8();
+            continue;
+        }
+
+        QString path = u'[' + operation.section + u"] -> ["_s + operation.argument + u']';
+        if (instance && operation.type == QLoaderTransactionPrivate::Copy && !instance->isCopyable(operation.argument))
+            return {.status = QLoaderError::Object, .message = path + u" : copy operation not allowed"_s};
+
+        if (instance && operation.type == QLoaderTransactionPrivate::Move && !instance->isMovable(operation.argument))
+            return {.status = QLoaderError::Object, .message = path + u" : move operation not allowed"_s};
+
+        moved.append({operation.argument, section});
+    }
 
     return {};
 }
 
-QLoaderError QLoaderTreePrivate::load(const QStringList &/*section*/)
+void QLoaderTreePrivate::rollback(const QList<QLoaderTransactionPrivate::Undo> &undo)
 {
-    if (loaded)
-        return {};
-    return {};
+    for (auto entry = undo.crbegin(); entry != undo.crend(); ++entry)
+    {
+        if (entry->type == QLoaderTransactionPrivate::Copy)
+        {
+            deleteRecursive(entry->settings);
+            continue;
+        }
+
+        QLoaderSettingsData &item = node(entry->settings);
+        if (entry->type == QLoaderTransactionPrivate::SetValue)
+        {
+            if (entry->utf8)
+                item.properties.insert(entry->name, *entry->utf8);
+            else
+                item.properties.remove(entry->name);
+
+            item.changed = entry->changed;
+            resetSnapshot(entry->settings->node);
+            continue;
+        }
+
+        removeChild(item.parent, entry->settings);
+        insertChild(entry->parent, entry->settings, entry->name, entry->index);
+        item.parent = entry->parent;
+        item.name = entry->name;
+        moveRecursive(entry->settings, node(entry->parent).level + 1);
+
+        for (QLoaderSettings *settings : entry->included)
+            node(settings).included = true;
+
+        for (QLoaderSettings *settings : entry->generated)
+            node(settings).generated = true;
+    }
 }
 
-QVariant QLoaderTreePrivate::fromString(const QString &value) const
+bool QLoaderTreePrivate::isFileChanged() const
 {
-    return d.converter.fromString(value);
+    return file->size() != fileSize ||
+           file->fileTime(QFileDevice::FileModificationTime).toMSecsSinceEpoch() != fileModified;
 }
 
-QString QLoaderTreePrivate::fromVariant(const QVariant &variant) const
+bool QLoaderTreePrivate::isGenerated(QLoaderSettings *settings) const
 {
-    return d.converter.fromVariant(variant);
+    const QLoaderSettingsData &item = node(settings);
+    return item.generated && item.base && item.parent &&
+           node(item.parent).base == node(item.base).parent && item.name == node(item.base).name;
 }
 
-void QLoaderTreePrivate::copyRecursive(QLoaderSettings *settings,
-                                       const QLoaderTreeSection &src,
-                                       const QLoaderTreeSection &dst)
+bool QLoaderTreePrivate::isIncludedParent(QLoaderSettings *parent) const
 {
-    QString itemSection = hash.data[settings].section;
+    const QLoaderSettingsData &item = node(parent);
+    return item.included || item.include.size();
+}
 
-    QString section = QLoaderTreeSectionAction<Copy>::section(itemSection.split(u'/'),
-                                                              src.section.toString().split(u'/'),
-                                                              dst.section.toString().split(u'/'));
+bool QLoaderTreePrivate::isSaving() const
+{
+    return d.saving();
+}
 
-    QLoaderSettings *copySettings = new QLoaderSettings(*this);
-    d.copied.append(copySettings);
-    hash.settings.sections[section] = copySettings;
+void QLoaderTreePrivate::removeNode(QLoaderSettings *settings)
+{
+    resetSnapshot(settings->node);
 
-    QStringView parentSection = ::parentSection(section);
+    QLoaderSettingsData &item = node(settings);
 
-    QLoaderSettings *parentSettings = hash.settings.sections[parentSection];
+    if (item.parent)
+        removeChild(item.parent, settings);
 
-    hash.data[parentSettings].children.push_back(copySettings);
+    for (QLoaderSettings *child : std::as_const(item.children))
+    {
+        nodes.children.remove({settings, node(child).name});
+        node(child).parent = nullptr;
+        resetSnapshot(child->node);
+    }
 
-    hash.data[copySettings].parent = parentSettings;
-    hash.data[copySettings].section = std::move(section);
-    hash.data[copySettings].className = hash.data[settings].className;
-    hash.data[copySettings].pluginName = hash.data[settings].pluginName;
-    hash.data[copySettings].properties = hash.data[settings].properties;
+    const QList<QLoaderSettings *> instances = nodes.instances.values(settings);
+    for (QLoaderSettings *instance : instances)
+    {
+        QLoaderSettingsData &data = node(instance);
+        resetSnapshot(instance->node);
+        materialize(item);
+        materialize(data);
+        for (auto i = item.properties.cbegin(), end = item.properties.cend(); i != end; ++i)
+        {
+            if (!data.properties.contains(i.key()))
+                data.properties.insert(i.key(), i.value());
+        }
 
-    for (QLoaderSettings *child : std::as_const(hash.data[settings].children))
-        copyRecursive(child, src, dst);
-}
+        setBase(instance, item.base);
+        data.generated = false;
+        data.changed = true;
+    }
 
-QLoaderError QLoaderTreePrivate::copy(QStringView section, QStringView to)
-{
-    QLoaderTreeSectionAction<Copy> cp(section, to, this);
+    setBase(settings, nullptr);
 
-    QLoaderError error;
-    if ((error = cp.error()))
-        return error;
+    if (settings == d.root.settings)
+        d.root.settings = nullptr;
 
-    mutex.lock();
-    copyRecursive(cp.src.settings, cp.src, cp.dst);
-    QLoaderSettings *settings = hash.settings.sections[cp.dst.section];
-    QObject *parent = hash.data[hash.settings.sections[cp.dst.parent.section]].object;
-    mutex.unlock();
+    if (settings == d.shell.settings)
+        d.shell.settings = nullptr;
 
-    error = loadRecursive(settings, parent);
+    for (int subscription : changes.sections.values(settings))
+        changes.subscriptions.remove(subscription);
+    changes.sections.remove(settings);
 
-    mutex.lock();
-    d.copied.clear();
-    mutex.unlock();
+    if (item.evicted)
+        evicted -= item.evictedSize;
 
-    if (error.status)
-    {
-        mutex.lock();
-        removeRecursive(cp.dst.settings);
-        mutex.unlock();
+    nodes.objects.remove(item.object);
+    nodes.settings[settings->node] = nullptr;
+    nodes.free.append(settings->node);
+    ++nodes.generations[settings->node];
+    item = {};
+}
 
-        return error;
-    }
+void QLoaderTreePrivate::removeChild(QLoaderSettings *parent, QLoaderSettings *settings)
+{
+    node(parent).children.removeOne(settings);
+    nodes.children.remove({parent, node(settings).name});
+    resetSnapshot(parent->node);
+    resetSnapshot(settings->node);
+}
 
-    emitSettingsChanged();
+void QLoaderTreePrivate::removeRecursive(QLoaderSettings */*settings*/)
+{
 
-    return {};
 }
 
-bool QLoaderTreePrivate::isSaving() const
+void QLoaderTreePrivate::setBase(QLoaderSettings *settings, QLoaderSettings *base)
 {
-    return d.saving();
+    QLoaderSettingsData &item = node(settings);
+    if (item.base)
+        nodes.instances.remove(item.base, settings);
+
+    if ((item.base = base))
+        nodes.instances.insert(base, settings);
 }
 
-void QLoaderTreePrivate::removeRecursive(QLoaderSettings */*settings*/)
+void QLoaderTreePrivate::sectionsRecursive(QLoaderSettings *settings, const QString &section, QStringList &sections) const
+{
+    sections.append(section);
+
+    for (QLoaderSettings *child : node(settings).children)
+        sectionsRecursive(child, section + u'/' + node(child).name.toString(), sections);
+}
+
+void QLoaderTreePrivate::resetSnapshot()
 {
+    snapshotReset = true;
+}
 
+void QLoaderTreePrivate::resetSnapshot(int node)
+{
+    if (loaded && !snapshotReset)
+        snapshotChanged.append(node);
 }
 
-void QLoaderTreePrivate::saveItem(const QLoaderSettingsData &item, QTextStream &out)
+void QLoaderTreePrivate::saveItem(const QLoaderSettingsData &item, const QString &section, QTextStream &out)
 {
-    out << "\n[" << item.section << "]\n";
+    out << "\n[" << section << "]\n";
     out << "class = " << item.className << '\n';
 
     if (item.pluginName.size())
         out << "plugin = " << item.pluginName << '\n';
 
-    QMapIterator<QString, QLoaderProperty> i(item.properties);
-    while (i.hasNext())
-    {
-        i.next();
-        out << i.key() << " = " << i.value() << '\n';
-    }
+    if (item.include.size())
+        out << "include = " << item.include << '\n';
 
-    QLoaderSaveInterface *resources = qobject_cast<QLoaderSaveInterface *>(item.object);
-    if (resources)
-        resources->save();
+    if (item.base)
+        out << "template = " << this->section(item.base) << '\n';
+
+    for (auto i = item.properties.cbegin(), end = item.properties.cend(); i != end; ++i)
+        out << i.key().toUtf8() << " = " << i.value() << '\n';
+
+    saveObject(item.object);
 }
 
-void QLoaderTreePrivate::saveRecursive(QLoaderSettings *settings, QTextStream &out)
+void QLoaderTreePrivate::saveRecursive(QLoaderSettings *settings, const QString &section, QTextStream &out)
 {
-    const QLoaderSettingsData &item = hash.data[settings];
-    saveItem(item, out);
+    QLoaderSettingsData &item = node(settings);
+    materialize(item);
+    saveItem(item, section, out);
 
     for (QLoaderSettings *child : item.children)
-        saveRecursive(child, out);
+    {
+        if (!node(child).included && !node(child).generated)
+            saveRecursive(child, section + u'/' + node(child).name.toString(), out);
+    }
 }
 
 QLoaderError QLoaderTreePrivate::save()
 {
     QLoaderError error{.status = QLoaderError::Access, .message = u"read-only file"_s};
+    if (loaded && staticTree)
+        return error;
+
+    if (loaded && evicted && isFileChanged())
+        return {.status = QLoaderError::Access, .message = u"file changed"_s};
+
     if (loaded)
     {
         Saving saving(&d.saving);
@@ -1060,24 +2800,76 @@ QLoaderError QLoaderTreePrivate::save()
         if (!ofile.open(QIODevice::WriteOnly))
             return error;
 
-        QTextStream out(&ofile);
+        if (cbor)
+        {
+            QLoaderError exportError = exportTree(&ofile, QLoaderTree::CborFormat, true);
+            if (!exportError && !ofile.flush())
+                exportError = {.status = QLoaderError::Access, .message = u"write error"_s};
+
+            if (exportError)
+            {
+                ofile.remove();
+                return exportError;
+            }
+        }
+        else
+        {
+            QTextStream out(&ofile);
+
+            if (d.shebang.size())
+                out << d.shebang << '\n';
+
+            bool written{};
+            if (compressed)
+            {
+                out.flush();
+
+                GzipDevice gzip(&ofile);
+                if (gzip.open(QIODevice::WriteOnly))
+                {
+                    QTextStream zout(&gzip);
+                    saveRecursive(d.root.settings, section(d.root.settings), zout);
+                    zout.flush();
+                    gzip.close();
+
+                    written = zout.status() == QTextStream::Ok && !gzip.failed;
+                }
+            }
+            else
+            {
+                saveRecursive(d.root.settings, section(d.root.settings), out);
+                written = true;
+            }
 
-        if (d.shebang.size())
-            out << d.shebang << '\n';
+            out.flush();
+            if (!written || out.status() != QTextStream::Ok || !ofile.flush())
+            {
+                ofile.remove();
+                return {.status = QLoaderError::Access, .message = u"write error"_s};
+            }
+        }
 
-        saveRecursive(d.root.settings, out);
         ofile.close();
 
         file->close();
         if (!file->remove())
+        {
+            ofile.remove();
             return error;
+        }
 
-        ofile.rename(fileName);
+        if (!ofile.rename(fileName))
+            return {.status = QLoaderError::Access, .message = u"write error"_s};
 
         if (!file->open(QIODevice::ReadOnly))
             return error;
 
         file->setPermissions(permissions);
+        fileSize = file->size();
+        fileModified = file->fileTime(QFileDevice::FileModificationTime).toMSecsSinceEpoch();
+
+        for (QLoaderSettingsData &item : nodes.data)
+            item.offset = -1;
 
         modified = false;
     }
@@ -1090,14 +2882,182 @@ QLoaderError QLoaderTreePrivate::save()
     return error;
 }
 
-void QLoaderTreePrivate::setProperties(const QLoaderSettingsData &item, QObject *object)
+QLoaderSettings *QLoaderTreePrivate::resolve(QLoaderSettings *settings, QStringView relative) const
+{
+    for (QStringView name : QStringTokenizer{relative, u'/', Qt::SkipEmptyParts})
+    {
+        if (name == u".")
+            continue;
+
+        if (name == u"..")
+            settings = node(settings).parent;
+        else
+            settings = child(settings, atoms.find(name));
+
+        if (!settings)
+            return nullptr;
+    }
+
+    return settings;
+}
+
+QString QLoaderTreePrivate::section(QLoaderSettings *settings) const
+{
+    QString section;
+    for (; settings; settings = node(settings).parent)
+    {
+        const QString name = node(settings).name.toString();
+        section = section.isEmpty() ? name : name + u'/' + section;
+    }
+
+    return section;
+}
+
+QLoaderSettings *QLoaderTreePrivate::instance(const QLoaderSnapshot &snapshot,
+                                              const QLoaderSettings *settings,
+                                              QObject *object) const
+{
+    if (settings->d_ptr != this)
+        return nullptr;
+
+    const QLoaderSnapshot::Node *item = snapshot.node(settings->node);
+    return (item && item->object == object ? item->instance : nullptr);
+}
+
+void QLoaderTreePrivate::writeCompiled(const CompiledHeader &header)
+{
+    QSaveFile cache(compiledFileName(file->fileName()));
+    if (!cache.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream out(&cache);
+    out.setVersion(QDataStream::Qt_6_8);
+
+    out << CompiledHeader::magic << CompiledHeader::version
+        << header.size << header.modified << header.digest;
+
+    out << d.shebang << quint32(nodes.settings.size() - nodes.settings.count(nullptr));
+    compileRecursive(d.root.settings, section(d.root.settings), out);
+
+    if (out.status() == QDataStream::Ok)
+        cache.commit();
+}
+
+void QLoaderTreePrivate::publishSnapshot()
+{
+    if (!loaded || (!snapshotReset && snapshotChanged.isEmpty()))
+        return;
+
+    QLoaderSnapshot *snapshot{};
+    if (!loadOptions.testFlag(QLoaderTree::LowMemory))
+    {
+        const QLoaderSnapshot *current = published.load();
+        if (snapshotReset || !current)
+        {
+            snapshot = new QLoaderSnapshot;
+            for (int node = 0; node < nodes.settings.size(); ++node)
+            {
+                if (nodes.settings.at(node))
+                    snapshotNode(*snapshot, node);
+            }
+        }
+        else
+        {
+            snapshot = new QLoaderSnapshot(*current);
+            std::sort(snapshotChanged.begin(), snapshotChanged.end());
+            snapshotChanged.erase(std::unique(snapshotChanged.begin(), snapshotChanged.end()), snapshotChanged.end());
+
+            for (int node : std::as_const(snapshotChanged))
+                snapshotNode(*snapshot, node);
+        }
+
+        snapshot->root = (d.root.settings ? d.root.settings->node : -1);
+    }
+
+    snapshotChanged.clear();
+    snapshotReset = false;
+
+    const QLoaderSnapshot *previous = published.exchange(snapshot);
+    if (!previous)
+        return;
+
+    const quint32 epoch = snapshotEpoch.fetch_add(1);
+    while (snapshotReaders[epoch & 1].load(std::memory_order_acquire))
+        QThread::yieldCurrentThread();
+
+    delete previous;
+}
+
+void QLoaderTreePrivate::snapshotNode(QLoaderSnapshot &snapshot, int node)
+{
+    if (!nodes.settings.at(node))
+    {
+        snapshot.setNode(node, nullptr);
+        return;
+    }
+
+    QLoaderSettingsData &item = nodes.data[node];
+    materialize(item);
+
+    auto snapshotNode = std::make_shared<QLoaderSnapshot::Node>();
+    snapshotNode->name = item.name;
+    snapshotNode->parent = (item.parent ? item.parent->node : -1);
+    snapshotNode->base = (item.base ? item.base->node : -1);
+    snapshotNode->className = item.className;
+    snapshotNode->pluginName = item.pluginName;
+    snapshotNode->object = item.object;
+    snapshotNode->instance = (item.object ? nodes.objects.value(item.object) : nullptr);
+    snapshotNode->properties = item.properties;
+
+    snapshotNode->children.reserve(item.children.size());
+    for (QLoaderSettings *child : item.children)
+        snapshotNode->children.append({this->node(child).name, child->node});
+
+    std::sort(snapshotNode->children.begin(), snapshotNode->children.end(),
+              [](const std::pair<QLoaderAtom, int> &lhs, const std::pair<QLoaderAtom, int> &rhs)
+              { return lhs.first.view() < rhs.first.view(); });
+
+    snapshot.setNode(node, std::move(snapshotNode));
+}
+
+int QLoaderTreePrivate::subscribe(QStringView section,
+                                  QObject *context,
+                                  std::function<void(const QLoaderChange &)> function)
+{
+    QLoaderSettings *settings{};
+    if (!context || !function || (section.size() && !(settings = find(section))))
+        return 0;
+
+    int id = ++changes.lastId;
+    changes.subscriptions.insert(id, {settings, context, std::move(function)});
+    changes.sections.insert(settings, id);
+
+    QObject::connect(context, &QObject::destroyed, q_ptr, [this, id]
+    {
+        QMutexLocker locker(&mutex);
+        unsubscribe(id);
+    });
+
+    return id;
+}
+
+void QLoaderTreePrivate::unsubscribe(int subscription)
+{
+    if (auto i = changes.subscriptions.constFind(subscription); i != changes.subscriptions.cend())
+    {
+        changes.sections.remove(i->settings, subscription);
+        changes.subscriptions.erase(i);
+    }
+}
+
+void QLoaderTreePrivate::setProperties(QLoaderSettingsData &item, QObject *object)
 {
-    object->setObjectName(objectName(item.section));
+    object->setObjectName(item.name.toString());
 
     auto value = [&item, this](const QString &key, const QVariant defaultValue = QVariant())
     {
-        if (item.properties.contains(key))
-            return fromString(item.properties[key]);
+        if (const QLoaderProperty *property = this->property(item, atoms.find(key)))
+            return fromString(QString::fromUtf8(property->utf8));
 
         return defaultValue;
     };
@@ -4,94 +4,398 @@
 #ifndef QLOADERTREE_P_H
 #define QLOADERTREE_P_H
 
+#include "qloadertree.h"
+#include "qloaderarena_p.h"
+#include "qloaderatom_p.h"
+#include "qloaderpropertymap_p.h"
+#include "qloadersettings.h"
+#include "qloaderstatictree.h"
 #include <QHash>
-#include <QMap>
 #include <QMutex>
+#include <QPointer>
+#include <atomic>
+#include <memory>
 
+class CompiledHeader;
+class QDataStream;
 class QFile;
+class QIODevice;
 class QLoaderError;
-class QLoaderSettings;
 class QLoaderTree;
 class QLoaderTreePrivateData;
 class QLoaderTreeSection;
 class QLoaderShell;
 class QTextStream;
-
-using QLoaderProperty = QString;
+class SettingsExport;
+class SettingsLine;
+class SettingsReader;
 
 struct QLoaderSettingsData
 {
     QLoaderSettings *parent{};
     int sectionLine{};
-    QString section;
-    int level;
+    QLoaderAtom name;
+    int level{};
     QByteArray className;
     QString pluginName;
+    QString include;
+    bool included{};
+    bool generated{};
+    QLoaderStaticSection::Factory factory{};
+    QLoaderSettings *base{};
+    qint64 offset{-1};
+    bool accessed{};
+    bool changed{};
+    bool evicted{};
+    qint64 evictedSize{};
+    bool stale{};
+    QList<QByteArray> views;
     QObject *object{};
     QList<QLoaderSettings *> settings;
-    QMap<QString, QLoaderProperty> properties;
+    QLoaderPropertyMap properties;
     QList<QLoaderSettings *> children;
 };
 
+class QLoaderSnapshot
+{
+public:
+    class Node
+    {
+    public:
+        QLoaderAtom name;
+        int parent{-1};
+        int base{-1};
+        QByteArray className;
+        QString pluginName;
+        QObject *object{};
+        QLoaderSettings *instance{};
+        QLoaderPropertyMap properties;
+        QList<std::pair<QLoaderAtom, int>> children;
+    };
+
+    class Leaf
+    {
+    public:
+        std::shared_ptr<const Node> nodes[64];
+    };
+
+    class Branch
+    {
+    public:
+        std::shared_ptr<Leaf> leaves[64];
+    };
+
+    QList<std::shared_ptr<Branch>> branches;
+    int root{-1};
+
+    int child(int parent, QByteArrayView name) const
+    {
+        if (parent == -1)
+        {
+            const Node *item = node(root);
+            return (item && item->name.view() == name ? root : -1);
+        }
+
+        const QList<std::pair<QLoaderAtom, int>> &children = node(parent)->children;
+        auto i = std::lower_bound(children.cbegin(), children.cend(), name,
+                                  [](const std::pair<QLoaderAtom, int> &child, QByteArrayView name)
+                                  { return child.first.view() < name; });
+
+        return (i != children.cend() && i->first.view() == name ? i->second : -1);
+    }
+
+    bool contains(int node) const { return this->node(node); }
+
+    int find(QByteArrayView section) const
+    {
+        int node = -1;
+        for (qsizetype from = 0, to; from <= section.size(); from = to + 1)
+        {
+            if ((to = section.indexOf('/', from)) == -1)
+                to = section.size();
+
+            if ((node = child(node, section.sliced(from, to - from))) == -1)
+                return -1;
+        }
+
+        return node;
+    }
+
+    const Node *node(int node) const
+    {
+        if (node < 0 || (node >> 12) >= branches.size())
+            return nullptr;
+
+        const std::shared_ptr<Leaf> &leaf = branches.at(node >> 12)->leaves[(node >> 6) & 63];
+        return (leaf ? leaf->nodes[node & 63].get() : nullptr);
+    }
+
+    const QLoaderProperty *property(int node, QByteArrayView key) const
+    {
+        for (const Node *item = this->node(node); item; item = this->node(item->base))
+        {
+            if (auto i = item->properties.constFind(key); i != item->properties.cend())
+                return &*i;
+        }
+
+        return nullptr;
+    }
+
+    QString section(int node) const
+    {
+        QString section;
+        for (const Node *item = this->node(node); item; item = this->node(item->parent))
+            section = section.isEmpty() ? item->name.toString() : item->name.toString() + u'/' + section;
+
+        return section;
+    }
+
+    void setNode(int node, std::shared_ptr<const Node> item)
+    {
+        while ((node >> 12) >= branches.size())
+            branches.append(std::make_shared<Branch>());
+
+        std::shared_ptr<Branch> &branch = branches[node >> 12];
+        if (branch.use_count() > 1)
+            branch = std::make_shared<Branch>(*branch);
+
+        std::shared_ptr<Leaf> &leaf = branch->leaves[(node >> 6) & 63];
+        if (!leaf)
+            leaf = std::make_shared<Leaf>();
+        else if (leaf.use_count() > 1)
+            leaf = std::make_shared<Leaf>(*leaf);
+
+        leaf->nodes[node & 63] = std::move(item);
+    }
+};
+
+class QLoaderSubscription
+{
+public:
+    QLoaderSettings *settings{};
+    QPointer<QObject> context;
+    std::function<void(const QLoaderChange &)> function;
+};
+
+class QLoaderNotification
+{
+public:
+    QPointer<QObject> context;
+    std::function<void(const QLoaderChange &)> function;
+    QLoaderChange change;
+};
+
+class QLoaderTransactionPrivate
+{
+public:
+    enum Type
+    {
+        Copy,
+        Move,
+        SetValue
+    };
+
+    class Operation
+    {
+    public:
+        Type type;
+        QString section;
+        QString argument;
+        QVariant value;
+        QByteArray utf8;
+    };
+
+    class Undo
+    {
+    public:
+        Type type;
+        QLoaderSettings *settings{};
+        QLoaderSettings *parent{};
+        QLoaderAtom name;
+        qsizetype index{};
+        bool changed{};
+        std::optional<QByteArray> utf8;
+        QList<QLoaderSettings *> included;
+        QList<QLoaderSettings *> generated;
+    };
+
+    QLoaderTree *const tree;
+    QList<Operation> operations;
+};
+
 class QLoaderTreePrivate
 {
     QLoaderTreePrivateData &d;
-    alignas(8) std::byte d_storage[184];
+    alignas(8) std::byte d_storage[160];
 
-    void copyRecursive(QLoaderSettings *settings,
-                       const QLoaderTreeSection &src,
-                       const QLoaderTreeSection &dst);
-    void dumpRecursive(QLoaderSettings *settings) const;
+    QLoaderError apply(const QLoaderTransactionPrivate::Operation &operation,
+                       QList<QLoaderTransactionPrivate::Undo> &undo,
+                       QList<QLoaderSettings *> &copies);
+    QLoaderError checkRecursive(QLoaderSettings *settings, QLoaderTree::CheckOptions options);
+    void compileRecursive(QLoaderSettings *settings, const QString &section, QDataStream &out);
+    QLoaderSettings *copyRecursive(QLoaderSettings *settings, QLoaderSettings *parent, QLoaderAtom name);
+    void deleteRecursive(QLoaderSettings *settings);
+    void dumpRecursive(QLoaderSettings *settings, const QString &section);
+    bool endSection(SettingsReader &reader);
+    void exportRecursive(QLoaderSettings *settings, const QString &section, SettingsExport &out, bool saveObjects);
+    void instantiateRecursive(QLoaderSettings *base, QLoaderSettings *parent);
     QLoaderError load(const QStringList &section);
     QLoaderError loadRecursive(QLoaderSettings *settings, QObject *parent);
-    void moveRecursive(QLoaderSettings *settings,
-                       const QLoaderTreeSection &src,
-                       const QLoaderTreeSection &dst);
+    void moveRecursive(QLoaderSettings *settings, int level, QLoaderTransactionPrivate::Undo *undo = nullptr);
+    QLoaderError prepare(QList<QLoaderTransactionPrivate::Operation> &operations);
+    bool readCompiled(const CompiledHeader &source);
+    bool readCbor(SettingsReader &reader, QByteArrayView data);
+    bool readInclude(SettingsReader &reader, QLoaderSettings *settings);
+    bool readLine(SettingsReader &reader, const SettingsLine &line);
+    bool readProperty(SettingsReader &reader, QLoaderAtom key, QByteArray &&value);
     QLoaderError readSettings();
+    QLoaderError readStatic();
+    bool readTemplates(SettingsReader &reader);
     void removeRecursive(QLoaderSettings *settings);
-    void saveItem(const QLoaderSettingsData &item, QTextStream &out);
-    void saveRecursive(QLoaderSettings *settings, QTextStream &out);
+    void rollback(const QList<QLoaderTransactionPrivate::Undo> &undo);
+    void saveItem(const QLoaderSettingsData &item, const QString &section, QTextStream &out);
+    void saveRecursive(QLoaderSettings *settings, const QString &section, QTextStream &out);
+    void sectionsRecursive(QLoaderSettings *settings, const QString &section, QStringList &sections) const;
+    void snapshotNode(QLoaderSnapshot &snapshot, int node);
+    void writeCompiled(const CompiledHeader &header);
 
 public:
     QLoaderTree *const q_ptr;
     QFile *file{};
+    QLoaderTree::LoadOptions loadOptions;
     QMutex mutex;
     bool loaded{};
     bool modified{};
+    bool compressed{};
+    bool cbor{};
+    qint64 evicted{};
+    qint64 fileSize{-1};
+    qint64 fileModified{};
+    const QLoaderStaticTree *staticTree{};
+    QLoaderArena<QLoaderSettings> arena;
+    std::atomic<const QLoaderSnapshot *> published{};
+    std::atomic<quint32> snapshotEpoch{};
+    std::atomic<int> snapshotReaders[2]{};
+    QList<int> snapshotChanged;
+    bool snapshotReset{};
+    std::optional<QLoaderError> parsed;
+    bool checking{};
 
     std::optional<QString> errorMessage;
     std::optional<QString> infoMessage;
     std::optional<QString> warningMessage;
 
+    QLoaderAtomTable atoms;
+
     struct
     {
-        struct
-        {
-            QHash<QString, QLoaderSettings *> sections;
-            QHash<QObject *, QLoaderSettings *> objects;
+        QList<QLoaderSettingsData> data;
+        QList<QLoaderSettings *> settings;
+        QList<quint32> generations;
+        QList<int> free;
+        QHash<QObject *, QLoaderSettings *> objects;
+        QHash<std::pair<QLoaderSettings *, QLoaderAtom>, QLoaderSettings *> children;
+        QMultiHash<QLoaderSettings *, QLoaderSettings *> instances;
 
-        } settings;
+    } nodes;
 
-        QHash<QLoaderSettings *, QLoaderSettingsData> data;
+    struct
+    {
+        QHash<int, QLoaderSubscription> subscriptions;
+        QMultiHash<QLoaderSettings *, int> sections;
+        QList<QLoaderNotification> pending;
+        int lastId{};
 
-    } hash;
+    } changes;
 
     QLoaderTreePrivate(const QString &fileName, QLoaderTree *q);
+    QLoaderTreePrivate(const QLoaderStaticTree &tree, QLoaderTree *q);
     virtual ~QLoaderTreePrivate();
 
-    QObject *builtin(QLoaderSettings *settings, QObject *parent);
+    QObject *builtin(QLoaderStaticSection::Factory factory, QLoaderSettings *settings, QObject *parent);
+    void changed(QLoaderChange::Kind kind, QLoaderSettings *settings, const QString &key = {},
+                 const QString &from = {}, QLoaderSettings *parent = nullptr);
+    QLoaderSettings *child(QLoaderSettings *parent, QLoaderAtom name) const;
+    QLoaderError check(QLoaderTree::CheckOptions options);
+    QLoaderError commit(QList<QLoaderTransactionPrivate::Operation> &operations);
     QLoaderError copy(QStringView section, QStringView to);
-    void dump(QLoaderSettings *settings) const;
+    void deleteSettings(QLoaderSettings *settings);
+    void dump(QLoaderSettings *settings);
     void emitSettingsChanged();
+    qint64 evict(bool all);
+    QLoaderError exportTree(QIODevice *device, QLoaderTree::ExportFormat format, bool saveObjects = false);
     QObject *external(QLoaderError &error, QLoaderSettings *settings, QObject *parent);
+    QLoaderSettings *find(QByteArrayView section) const;
+    QLoaderSettings *find(QStringView section) const;
+    QLoaderSettings *find(QLoaderSectionHandle handle) const;
     QVariant fromString(const QString &value) const;
     QString fromVariant(const QVariant &variant) const;
+    QLoaderSectionHandle handle(QLoaderSettings *settings) const;
+    bool isFileChanged() const;
+    bool isGenerated(QLoaderSettings *settings) const;
+    bool isIncludedParent(QLoaderSettings *parent) const;
     bool isSaving() const;
     QLoaderError load();
+    void insertChild(QLoaderSettings *parent, QLoaderSettings *settings, QLoaderAtom name, qsizetype index = -1);
+    int insertNode(QLoaderSettings *settings);
+    QLoaderSettings *instance(const QLoaderSnapshot &snapshot, const QLoaderSettings *settings, QObject *object) const;
+    bool materialize(QLoaderSettingsData &item);
     QLoaderError move(QStringView section, QStringView to);
+    QLoaderSettings *newSettings();
+    void notify();
     QLoaderShell *newShellInstance();
+    QLoaderSettingsData &node(QLoaderSettings *settings) { return nodes.data[settings->node]; }
+    const QLoaderSettingsData &node(QLoaderSettings *settings) const { return nodes.data.at(settings->node); }
+    bool pluginLibrary(QLoaderSettings *settings, QString &libraryName);
+    const QLoaderProperty *property(QLoaderSettingsData &item, QLoaderAtom key);
+    void removeChild(QLoaderSettings *parent, QLoaderSettings *settings);
+    void removeNode(QLoaderSettings *settings);
+    void publishSnapshot();
+    void resetSnapshot();
+    void resetSnapshot(int node);
+    QLoaderSettings *resolve(QLoaderSettings *settings, QStringView relative) const;
     QLoaderError save();
-    void setProperties(const QLoaderSettingsData &item, QObject *object);
+    QString section(QLoaderSettings *settings) const;
+    void setBase(QLoaderSettings *settings, QLoaderSettings *base);
+    void setProperties(QLoaderSettingsData &item, QObject *object);
+    int subscribe(QStringView section, QObject *context, std::function<void(const QLoaderChange &)> function);
+    void unsubscribe(int subscription);
+};
+
+class QLoaderSnapshotReader
+{
+    Q_DISABLE_COPY_MOVE(QLoaderSnapshotReader)
+
+    QLoaderTreePrivate &d;
+    quint32 slot{};
+    const QLoaderSnapshot *snapshot{};
+
+public:
+    explicit QLoaderSnapshotReader(QLoaderTreePrivate &d)
+    :   d(d)
+    {
+        for (;;)
+        {
+            slot = d.snapshotEpoch.load() & 1;
+            d.snapshotReaders[slot].fetch_add(1);
+            if ((d.snapshotEpoch.load() & 1) == slot)
+                break;
+
+            d.snapshotReaders[slot].fetch_sub(1, std::memory_order_release);
+        }
+
+        snapshot = d.published.load();
+    }
+
+    ~QLoaderSnapshotReader()
+    {
+        d.snapshotReaders[slot].fetch_sub(1, std::memory_order_release);
+    }
+
+    explicit operator bool() const { return snapshot; }
+    bool contains(int node) const { return snapshot && snapshot->contains(node); }
+    const QLoaderSnapshot &operator*() const { return *snapshot; }
+    const QLoaderSnapshot *operator->() const { return snapshot; }
 };
 
 #endif // QLOADERTREE_P_H
@@ -0,0 +1,453 @@
+// Copyright (C) 2026 Sergey Naumov <sergey@naumov.io>
+// SPDX-License-Identifier: 0BSD
+
+#ifndef QLOADERVARIANTCONVERTER_P_H
+#define QLOADERVARIANTCONVERTER_P_H
+
+#include <QColor>
+#include <QFont>
+#include <QLocale>
+#include <QPoint>
+#include <QRect>
+#include <QSize>
+#include <QStringList>
+#include <QVariant>
+#include <limits>
+
+class QLoaderVariantConverter
+{
+    class Reader
+    {
+        QStringView text;
+
+    public:
+        qsizetype position{};
+
+        explicit Reader(QStringView string)
+        :   text(string)
+        { }
+
+        bool atEnd()
+        {
+            skipSpaces();
+            return position == text.size();
+        }
+
+        bool peek(QChar c)
+        {
+            skipSpaces();
+            return position < text.size() && text[position] == c;
+        }
+
+        bool read(QChar c)
+        {
+            if (!peek(c))
+                return false;
+
+            ++position;
+            return true;
+        }
+
+        bool read(QLatin1StringView word)
+        {
+            skipSpaces();
+            if (!text.sliced(position).startsWith(word))
+                return false;
+
+            position += word.size();
+            return true;
+        }
+
+        bool readInt(int &value)
+        {
+            skipSpaces();
+            const bool negative = position < text.size() && text[position] == u'-';
+            qsizetype i = position + negative;
+            qint64 number{};
+
+            for (; i < text.size() && text[i].unicode() >= u'0' && text[i].unicode() <= u'9'; ++i)
+            {
+                number = number * 10 + (text[i].unicode() - u'0');
+                if (number > qint64(std::numeric_limits<int>::max()) + negative)
+                    return false;
+            }
+
+            if (i == position + negative)
+                return false;
+
+            position = i;
+            value = int(negative ? -number : number);
+            return true;
+        }
+
+        bool readString(QString &value)
+        {
+            if (!read(u'"'))
+                return false;
+
+            value.clear();
+            for (qsizetype i = position; i < text.size(); ++i)
+            {
+                if (text[i] == u'"')
+                {
+                    position = i + 1;
+                    return true;
+                }
+
+                if (text[i] == u'\\' && ++i == text.size())
+                    break;
+
+                value += text[i];
+            }
+
+            return false;
+        }
+
+        QStringView readToken()
+        {
+            skipSpaces();
+            const qsizetype start = position;
+            while (position < text.size() && text[position] != u',' && text[position] != u')')
+                ++position;
+
+            return text.sliced(start, position - start).trimmed();
+        }
+
+        QStringView readUntil(QChar c)
+        {
+            skipSpaces();
+            const qsizetype end = text.indexOf(c, position);
+            if (end == -1)
+                return {};
+
+            QStringView token = text.sliced(position, end - position).trimmed();
+            position = end;
+            return token;
+        }
+
+        void skipSpaces()
+        {
+            while (position < text.size() && text[position].isSpace())
+                ++position;
+        }
+    };
+
+    class Type
+    {
+    public:
+        QLatin1StringView prefix;
+        QMetaType::Type type;
+        bool (*read)(Reader &reader, QVariant &value);
+        QString (*write)(const QVariant &value);
+    };
+
+    static QString number(int value) { return QString::number(value); }
+
+    static QString quoted(const QString &value)
+    {
+        QString string(u'"');
+        for (QChar c : value)
+        {
+            if (c == u'"' || c == u'\\')
+                string += u'\\';
+
+            string += c;
+        }
+
+        return string += u'"';
+    }
+
+    static bool readScalar(QStringView token, QVariant &value)
+    {
+        if (token == QLatin1StringView("true") || token == QLatin1StringView("false"))
+        {
+            value = (token == QLatin1StringView("true"));
+            return true;
+        }
+
+        bool ok{};
+        if (const qlonglong integer = token.toLongLong(&ok); ok)
+        {
+            value = (integer == int(integer) ? QVariant(int(integer)) : QVariant(integer));
+            return true;
+        }
+
+        value = token.toDouble(&ok);
+        return ok;
+    }
+
+    static bool writeScalar(const QVariant &value, QString &string)
+    {
+        const int type = value.metaType().id();
+        if (type == QMetaType::Bool)
+            string = (value.toBool() ? QStringLiteral("true") : QStringLiteral("false"));
+        else if (type == QMetaType::Int || type == QMetaType::UInt ||
+                 type == QMetaType::LongLong || type == QMetaType::ULongLong)
+            string = value.toString();
+        else if (type == QMetaType::Double || type == QMetaType::Float)
+        {
+            string = QString::number(value.toDouble(), 'g', QLocale::FloatingPointShortest);
+            if (!string.contains(u'.') && !string.contains(u'e') && !string.contains(u'n'))
+                string += QLatin1StringView(".0");
+        }
+        else
+            return false;
+
+        return true;
+    }
+
+    static bool readByteArray(Reader &reader, QVariant &value)
+    {
+        QStringView base64 = reader.readUntil(u')');
+        if (!reader.read(u')'))
+            return false;
+
+        value = QByteArray::fromBase64(base64.toLatin1());
+        return true;
+    }
+
+    static QString writeByteArray(const QVariant &value)
+    {
+        return QString::fromLatin1(value.toByteArray().toBase64());
+    }
+
+    static bool readColor(Reader &reader, QVariant &value)
+    {
+        int r, g, b, a{255};
+        if (!reader.readInt(r) || !reader.read(u',') ||
+            !reader.readInt(g) || !reader.read(u',') ||
+            !reader.readInt(b))
+            return false;
+
+        if (reader.read(u',') && !reader.readInt(a))
+            return false;
+
+        if (!reader.read(u')'))
+            return false;
+
+        value = QColor(r, g, b, a);
+        return true;
+    }
+
+    static QString writeColor(const QVariant &value)
+    {
+        const QColor color = value.value<QColor>().toRgb();
+        QString string = number(color.red()) + QStringLiteral(", ") +
+                         number(color.green()) + QStringLiteral(", ") + number(color.blue());
+        if (color.alpha() != 255)
+            string += QStringLiteral(", ") + number(color.alpha());
+
+        return string;
+    }
+
+    static bool readFont(Reader &reader, QVariant &value)
+    {
+        QStringView description = reader.readUntil(u')');
+        QFont font;
+        if (!reader.read(u')') || !font.fromString(description.toString()))
+            return false;
+
+        value = font;
+        return true;
+    }
+
+    static QString writeFont(const QVariant &value)
+    {
+        return value.value<QFont>().toString();
+    }
+
+    static bool readPoint(Reader &reader, QVariant &value)
+    {
+        int x, y;
+        if (!reader.readInt(x) || !reader.read(u',') || !reader.readInt(y) || !reader.read(u')'))
+            return false;
+
+        value = QPoint(x, y);
+        return true;
+    }
+
+    static QString writePoint(const QVariant &value)
+    {
+        const QPoint point = value.toPoint();
+        return number(point.x()) + QStringLiteral(", ") + number(point.y());
+    }
+
+    static bool readRect(Reader &reader, QVariant &value)
+    {
+        int x, y, width, height;
+        if (!reader.readInt(x) || !reader.read(u',') ||
+            !reader.readInt(y) || !reader.read(u',') ||
+            !reader.readInt(width) || !reader.read(u',') ||
+            !reader.readInt(height) || !reader.read(u')'))
+            return false;
+
+        value = QRect(x, y, width, height);
+        return true;
+    }
+
+    static QString writeRect(const QVariant &value)
+    {
+        const QRect rect = value.toRect();
+        return number(rect.x()) + QStringLiteral(", ") + number(rect.y()) + QStringLiteral(", ") +
+               number(rect.width()) + QStringLiteral(", ") + number(rect.height());
+    }
+
+    static bool readSize(Reader &reader, QVariant &value)
+    {
+        int width, height;
+        if (!reader.readInt(width) || !reader.read(u',') || !reader.readInt(height) || !reader.read(u')'))
+            return false;
+
+        value = QSize(width, height);
+        return true;
+    }
+
+    static QString writeSize(const QVariant &value)
+    {
+        const QSize size = value.toSize();
+        return number(size.width()) + QStringLiteral(", ") + number(size.height());
+    }
+
+    static bool readStringList(Reader &reader, QVariant &value)
+    {
+        QStringList list;
+        if (!reader.read(u')'))
+        {
+            do
+            {
+                if (!reader.readString(list.emplace_back()))
+                    return false;
+            }
+            while (reader.read(u','));
+
+            if (!reader.read(u')'))
+                return false;
+        }
+
+        value = list;
+        return true;
+    }
+
+    static QString writeStringList(const QVariant &value)
+    {
+        QString string;
+        const QStringList list = value.toStringList();
+        for (const QString &item : list)
+            string += (string.isEmpty() ? QString() : QStringLiteral(", ")) + quoted(item);
+
+        return string;
+    }
+
+    static bool readVariantList(Reader &reader, QVariant &value)
+    {
+        QVariantList list;
+        if (!reader.read(u')'))
+        {
+            do
+            {
+                QVariant &item = list.emplace_back();
+                if (reader.peek(u'"'))
+                {
+                    QString string;
+                    if (!reader.readString(string))
+                        return false;
+
+                    item = string;
+                }
+                else if (reader.peek(u'Q'))
+                {
+                    if (!readType(reader, item))
+                        return false;
+                }
+                else if (!readScalar(reader.readToken(), item))
+                    return false;
+            }
+            while (reader.read(u','));
+
+            if (!reader.read(u')'))
+                return false;
+        }
+
+        value = list;
+        return true;
+    }
+
+    static QString writeVariantList(const QVariant &value)
+    {
+        QString string;
+        const QVariantList list = value.toList();
+        for (const QVariant &item : list)
+        {
+            QString scalar;
+            const Type *type = typeOf(item);
+            string += (string.isEmpty() ? QString() : QStringLiteral(", ")) +
+                      (type ? write(*type, item) : writeScalar(item, scalar) ? scalar : quoted(item.toString()));
+        }
+
+        return string;
+    }
+
+    static constexpr Type types[]
+    {
+        {QLatin1StringView("QByteArray"), QMetaType::QByteArray, readByteArray, writeByteArray},
+        {QLatin1StringView("QColor"), QMetaType::QColor, readColor, writeColor},
+        {QLatin1StringView("QFont"), QMetaType::QFont, readFont, writeFont},
+        {QLatin1StringView("QPoint"), QMetaType::QPoint, readPoint, writePoint},
+        {QLatin1StringView("QRect"), QMetaType::QRect, readRect, writeRect},
+        {QLatin1StringView("QSize"), QMetaType::QSize, readSize, writeSize},
+        {QLatin1StringView("QStringList"), QMetaType::QStringList, readStringList, writeStringList},
+        {QLatin1StringView("QVariantList"), QMetaType::QVariantList, readVariantList, writeVariantList}
+    };
+
+    static bool readType(Reader &reader, QVariant &value)
+    {
+        const qsizetype start = reader.position;
+        for (const Type &type : types)
+        {
+            if (reader.read(type.prefix) && reader.read(u'(') && type.read(reader, value))
+                return true;
+
+            reader.position = start;
+        }
+
+        return false;
+    }
+
+    static const Type *typeOf(const QVariant &variant)
+    {
+        for (const Type &type : types)
+            if (variant.metaType().id() == type.type)
+                return &type;
+
+        return nullptr;
+    }
+
+    static QString write(const Type &type, const QVariant &variant)
+    {
+        return QString(type.prefix) + u'(' + type.write(variant) + u')';
+    }
+
+public:
+    QVariant fromString(const QString &value) const
+    {
+        if (!value.startsWith(u'Q'))
+            return value;
+
+        Reader reader(value);
+        QVariant variant;
+        if (readType(reader, variant) && reader.atEnd())
+            return variant;
+
+        return value;
+    }
+
+    QString fromVariant(const QVariant &variant) const
+    {
+        if (const Type *type = typeOf(variant))
+            return write(*type, variant);
+
+        return variant.toString();
+    }
+};
+
+#endif // QLOADERVARIANTCONVERTER_P_H
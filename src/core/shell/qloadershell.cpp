@@ -50,11 +50,8 @@ void QLoaderShell::addCommand(QObject *object)
 
 bool QLoaderShell::cd(const QString &relative)
 {
-    QString absolute = d_ptr->section;
-    for (QStringView name : QStringTokenizer{relative, u'/'})
-        absolute.append(u'/' + name.toString());
-
-    if (tree()->contains(absolute))
+    QString absolute = tree()->resolve(d_ptr->section, relative);
+    if (absolute.size())
     {
         d_ptr->section = absolute;
 
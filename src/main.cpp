@@ -1,14 +1,23 @@
 // Copyright (C) 2022 Sergey Naumov <sergey@naumov.io>
 // SPDX-License-Identifier: 0BSD
 
+#include "qloadergenerator.h"
 #include "qloadertree.h"
 #include <QApplication>
 #include <QCommandLineParser>
 #include <QFileDialog>
 #include <QMessageBox>
+#include <QThreadPool>
 
 using namespace Qt::Literals::StringLiterals;
 
+static QString errorMessage(const QString &fileName, const QLoaderError &error)
+{
+    return fileName + u':' + QString::number(error.line) + u": "_s +
+           QVariant::fromValue(error.status).toString().toLower() +
+           u" error: "_s + error.message;
+}
+
 int main(int argc, char *argv[])
 {
     setlocale(LC_ALL, "");
@@ -18,7 +27,8 @@ int main(int argc, char *argv[])
     QScopedPointer<QCoreApplication> app([&]() -> QCoreApplication *
     {
         for (int i = 1; i < argc; ++i)
-            if (!qstrcmp(argv[i], "--no-gui"))
+            if (!qstrcmp(argv[i], "--no-gui") || !qstrcmp(argv[i], "--check") ||
+                !qstrncmp(argv[i], "--generate", 10))
                 return new QCoreApplication(argc, argv);
 
         return new QApplication(argc, argv);
@@ -37,9 +47,17 @@ int main(int argc, char *argv[])
     parser.addVersionOption();
 
     parser.addOption(QCommandLineOption({u"s"_s, u"section"_s}, u"Root section."_s));
+    parser.addOption(QCommandLineOption(u"cache"_s, u"Use compiled .qt6c cache."_s));
+    parser.addOption(QCommandLineOption(u"check"_s, u"Validate files without loading objects."_s));
+    parser.addOption(QCommandLineOption(u"check-plugins"_s, u"Validate that plugin libraries are found."_s));
+    parser.addOption(QCommandLineOption(u"generate"_s, u"Generate C++ source <output> and exit."_s, u"output"_s));
+    parser.addOption(QCommandLineOption(u"low-memory"_s, u"Evict properties after loading."_s));
+    parser.addOption(QCommandLineOption(u"name"_s, u"Generated tree variable <name>."_s, u"name"_s,
+                                        u"qtLoaderTree"_s));
     parser.addOption(QCommandLineOption(u"no-gui"_s, u"Start console application."_s));
+    parser.addOption(QCommandLineOption(u"parallel"_s, u"Parse large files on a thread pool."_s));
 
-    parser.addPositionalArgument(u"file"_s, u"Open .qt6 file."_s);
+    parser.addPositionalArgument(u"file"_s, u"Open .qt6 file."_s, u"file..."_s);
     parser.process(*app);
     QString fileName;
 
@@ -66,7 +84,62 @@ int main(int argc, char *argv[])
     else
         fileName = arguments.first();
 
+    if (parser.isSet(u"generate"_s))
+    {
+        QLoaderGenerator generator;
+        if (QLoaderError error = generator.generate(fileName, parser.value(u"generate"_s), parser.value(u"name"_s)))
+        {
+            qInfo().noquote() << errorMessage(fileName, error);
+            return -1;
+        }
+
+        return 0;
+    }
+
+    QLoaderTree::LoadOptions loadOptions;
+    if (parser.isSet(u"cache"_s))
+        loadOptions |= QLoaderTree::UseCompiledCache;
+
+    if (parser.isSet(u"parallel"_s))
+        loadOptions |= QLoaderTree::ParallelParse;
+
+    if (parser.isSet(u"low-memory"_s))
+        loadOptions |= QLoaderTree::LowMemory;
+
+    if (parser.isSet(u"check"_s))
+    {
+        QLoaderTree::CheckOptions checkOptions;
+        if (parser.isSet(u"check-plugins"_s))
+            checkOptions |= QLoaderTree::ResolvePlugins;
+
+        QList<QLoaderError> errors(arguments.size());
+        for (qsizetype i = 0; i < arguments.size(); ++i)
+        {
+            QThreadPool::globalInstance()->start([&, i]
+            {
+                QLoaderTree checkTree(arguments.at(i));
+                checkTree.setLoadOptions(loadOptions);
+                errors[i] = checkTree.check(checkOptions);
+            });
+        }
+        QThreadPool::globalInstance()->waitForDone();
+
+        int status{};
+        for (qsizetype i = 0; i < arguments.size(); ++i)
+        {
+            if (errors.at(i))
+            {
+                qInfo().noquote() << errorMessage(arguments.at(i), errors.at(i));
+                status = -1;
+            }
+        }
+
+        return status;
+    }
+
     QLoaderTree loaderTree(fileName);
+    loaderTree.setLoadOptions(loadOptions);
+
     if (QLoaderError error = loaderTree.load())
     {
         if (error.status == QLoaderError::Access)
@@ -84,9 +157,7 @@ int main(int argc, char *argv[])
                                             QMessageBox::Close);
             }
         }
-        QString message = fileName + u':' + QString::number(error.line) + u": "_s +
-                          QVariant::fromValue(error.status).toString().toLower() +
-                          u" error: "_s + error.message;;
+        QString message = errorMessage(fileName, error);
 
         if (coreApp)
         {
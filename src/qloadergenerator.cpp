@@ -0,0 +1,166 @@
+// Copyright (C) 2026 Sergey Naumov <sergey@naumov.io>
+// SPDX-License-Identifier: 0BSD
+
+#include "qloadergenerator.h"
+#include "qloadertree.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+using namespace Qt::Literals::StringLiterals;
+
+static QByteArray literal(QByteArrayView text)
+{
+    QByteArray result(1, '"');
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+            result.append('\\').append(c);
+        else if (uchar(c) < 0x20 || uchar(c) >= 0x7f)
+            result.append('\\').append(QByteArray::number(uchar(c), 8).rightJustified(3, '0'));
+        else
+            result.append(c);
+    }
+
+    return result.append('"');
+}
+
+static QByteArray factoryName(QLoaderStaticSection::Factory factory)
+{
+    static constexpr const char *names[]
+    {
+        "Unresolved",
+        "External",
+        "Shell",
+        "ShellCd",
+        "ShellExit",
+        "ShellSave",
+        "Terminal",
+        "MarkupEditor",
+        "NotFound"
+    };
+
+    return "QLoaderStaticSection::"_ba + names[factory];
+}
+
+bool QLoaderGenerator::error(QByteArrayView)
+{
+    status.line = lineNumber();
+    status.status = QLoaderError::Format;
+    status.message = u"string not valid"_s;
+
+    return false;
+}
+
+bool QLoaderGenerator::keyValue(QByteArrayView key, QByteArrayView value)
+{
+    if (sections.isEmpty())
+    {
+        status.line = lineNumber();
+        status.status = QLoaderError::Format;
+        status.message = u"section not set"_s;
+        return false;
+    }
+
+    if (key == "include")
+    {
+        status.line = lineNumber();
+        status.status = QLoaderError::Design;
+        status.message = u"include not supported in generated tree"_s;
+        return false;
+    }
+
+    Section &current = sections.last();
+
+    if (key == "class")
+        current.factory = QLoaderStaticSection::factoryOf(value);
+    else if (key == "template" && current.factory == QLoaderStaticSection::Unresolved)
+        current.factory = factories.value(value.toByteArray());
+
+    if (current.factory != QLoaderStaticSection::Unresolved)
+        factories.insert(current.section, current.factory);
+
+    properties.append({lineNumber(), key.toByteArray(), value.toByteArray()});
+    ++current.propertyCount;
+
+    return true;
+}
+
+bool QLoaderGenerator::section(QByteArrayView section)
+{
+    sections.append({lineNumber(), section.toByteArray(), {}, properties.size(), 0});
+
+    return true;
+}
+
+bool QLoaderGenerator::shebang(QByteArrayView line)
+{
+    shebangLine = line.toByteArray();
+
+    return true;
+}
+
+QLoaderError QLoaderGenerator::generate(const QString &fileName, const QString &outputName, const QString &name)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        status.status = QLoaderError::Access;
+        status.message = u"read error"_s;
+        return status;
+    }
+
+    if (!parse(&file))
+        return status;
+
+    if (properties.isEmpty())
+    {
+        status.line = sections.size() ? sections.first().line : 0;
+        status.status = QLoaderError::Design;
+        status.message = u"class name not set"_s;
+        return status;
+    }
+
+    if ((status = QLoaderTree(fileName).check()))
+        return status;
+
+    QByteArray out;
+    out += "// Generated by qtloader from " + QFileInfo(fileName).fileName().toUtf8() + ". Do not edit.\n\n";
+    out += "#include <QLoaderStaticTree>\n\n";
+
+    out += "static constexpr QLoaderStaticProperty properties[]\n{\n";
+    for (const Property &property : std::as_const(properties))
+    {
+        out += "    {" + QByteArray::number(property.line) + ", " +
+               literal(property.key) + ", " + literal(property.value) + "},\n";
+    }
+    out += "};\n\n";
+
+    out += "static constexpr QLoaderStaticSection sections[]\n{\n";
+    for (const Section &section : std::as_const(sections))
+    {
+        out += "    {" + QByteArray::number(section.line) + ", " + literal(section.section) + ", " +
+               factoryName(section.factory) + ", " + QByteArray::number(section.firstProperty) + ", " +
+               QByteArray::number(section.propertyCount) + "},\n";
+    }
+    out += "};\n\n";
+
+    const QByteArray variable = name.toUtf8();
+    out += "extern const QLoaderStaticTree " + variable + ";\n";
+    out += "constexpr QLoaderStaticTree " + variable + "\n{\n";
+    out += "    " + literal(QFileInfo(fileName).fileName().toUtf8()) + ",\n";
+    out += "    " + literal(shebangLine) + ",\n";
+    out += "    sections,\n";
+    out += "    " + QByteArray::number(sections.size()) + ",\n";
+    out += "    properties\n};\n";
+
+    QSaveFile output(outputName);
+    if (!output.open(QIODevice::WriteOnly) || output.write(out) != out.size() || !output.commit())
+    {
+        status.line = 0;
+        status.status = QLoaderError::Access;
+        status.message = u"write error"_s;
+    }
+
+    return status;
+}
@@ -0,0 +1,49 @@
+// Copyright (C) 2026 Sergey Naumov <sergey@naumov.io>
+// SPDX-License-Identifier: 0BSD
+
+#ifndef QLOADERGENERATOR_H
+#define QLOADERGENERATOR_H
+
+#include "qloadererror.h"
+#include "qloaderparser.h"
+#include "qloaderstatictree.h"
+#include <QHash>
+#include <QList>
+
+class QLoaderGenerator : public QLoaderParser
+{
+    class Property
+    {
+    public:
+        int line{};
+        QByteArray key;
+        QByteArray value;
+    };
+
+    class Section
+    {
+    public:
+        int line{};
+        QByteArray section;
+        QLoaderStaticSection::Factory factory{};
+        qsizetype firstProperty{};
+        qsizetype propertyCount{};
+    };
+
+    QLoaderError status;
+    QByteArray shebangLine;
+    QList<Section> sections;
+    QList<Property> properties;
+    QHash<QByteArray, QLoaderStaticSection::Factory> factories;
+
+protected:
+    bool error(QByteArrayView text) override;
+    bool keyValue(QByteArrayView key, QByteArrayView value) override;
+    bool section(QByteArrayView section) override;
+    bool shebang(QByteArrayView line) override;
+
+public:
+    QLoaderError generate(const QString &fileName, const QString &outputName, const QString &name);
+};
+
+#endif // QLOADERGENERATOR_H